@@ -61,6 +61,15 @@ string dev::contentsString(string const& _file)
 	return contentsGeneric<string>(_file);
 }
 
+string dev::readStandardInput()
+{
+	// Reads the input in one go instead of line by line. The trailing newline is kept for
+	// compatibility with the line-based reading, it is part of the source hashes.
+	string ret{istreambuf_iterator<char>(cin), istreambuf_iterator<char>()};
+	ret.push_back('\n');
+	return ret;
+}
+
 void dev::writeFile(std::string const& _file, bytesConstRef _data, bool _writeDeleteRename)
 {
 	namespace fs = boost::filesystem;
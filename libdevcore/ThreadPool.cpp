@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ThreadPool.cpp
+ * @date 2017
+ * Fixed set of threads that run the iterations of (possibly nested) parallel loops.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+
+ThreadPool::ThreadPool(unsigned _threads)
+{
+	for (unsigned i = 1; i < _threads; ++i)
+		m_workers.emplace_back([this]()
+		{
+			unique_lock<mutex> lock(m_mutex);
+			while (true)
+			{
+				m_condition.wait(lock, [&]() { return m_stopping || !m_loops.empty(); });
+				if (m_stopping)
+					break;
+				runIteration(lock, nullptr);
+			}
+		});
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(size_t _count, function<void(size_t)> const& _body)
+{
+	if (m_workers.empty() || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_body(i);
+		return;
+	}
+
+	auto loop = make_shared<Loop>(Loop{&_body, _count, 0, 0, _count, nullptr});
+	unique_lock<mutex> lock(m_mutex);
+	m_loops.push_back(loop);
+	m_condition.notify_all();
+	while (loop->finished < loop->count)
+		if (!runIteration(lock, loop))
+			m_condition.wait(lock, [&]() { return loop->finished == loop->count || !m_loops.empty(); });
+	if (loop->failure)
+		rethrow_exception(loop->failure);
+}
+
+bool ThreadPool::runIteration(unique_lock<mutex>& _lock, shared_ptr<Loop> const& _loop)
+{
+	shared_ptr<Loop> loop = _loop && _loop->next < _loop->count ? _loop : nullptr;
+	if (!loop)
+	{
+		if (m_loops.empty())
+			return false;
+		loop = m_loops.front();
+	}
+	size_t index = loop->next++;
+	if (loop->next == loop->count)
+		m_loops.erase(find(m_loops.begin(), m_loops.end(), loop));
+	_lock.unlock();
+
+	exception_ptr failure;
+	try
+	{
+		(*loop->body)(index);
+	}
+	catch (...)
+	{
+		failure = current_exception();
+	}
+
+	_lock.lock();
+	if (failure && index < loop->firstFailure)
+	{
+		loop->firstFailure = index;
+		loop->failure = failure;
+	}
+	if (++loop->finished == loop->count)
+		m_condition.notify_all();
+	return true;
+}
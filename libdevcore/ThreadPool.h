@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file ThreadPool.h
+ * @date 2017
+ * Fixed set of threads that run the iterations of (possibly nested) parallel loops.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Runs the iterations of parallel loops on a fixed set of worker threads.
+ * The thread that starts a loop takes part in it and, while it waits for the iterations run
+ * by others, also in other loops. Loops can therefore be nested without starting new threads:
+ * at most the workers and the threads calling into the pool are busy at any time.
+ */
+class ThreadPool: public boost::noncopyable
+{
+public:
+	/// Creates a pool that runs loops on @a _threads threads, including the calling thread.
+	explicit ThreadPool(unsigned _threads);
+	~ThreadPool();
+
+	/// @returns the number of threads loops run on, including the calling thread.
+	unsigned threads() const { return m_workers.size() + 1; }
+
+	/// Calls @a _body for all numbers from zero to @a _count - 1.
+	/// If calls throw, the exception of the call with the smallest number is rethrown after
+	/// all calls finished.
+	void parallelFor(size_t _count, std::function<void(size_t)> const& _body);
+
+private:
+	struct Loop
+	{
+		std::function<void(size_t)> const* body;
+		size_t count;
+		size_t next;
+		size_t finished;
+		size_t firstFailure;
+		std::exception_ptr failure;
+	};
+
+	/// Runs the next iteration of @a _loop or, if it has none left, of the first loop in the
+	/// queue. Expects @a _lock to be locked and locks it again before returning.
+	/// @returns false if there was nothing to run.
+	bool runIteration(std::unique_lock<std::mutex>& _lock, std::shared_ptr<Loop> const& _loop);
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	/// Loops that still have iterations to start, guarded by the mutex.
+	std::deque<std::shared_ptr<Loop>> m_loops;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+}
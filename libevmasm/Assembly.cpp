@@ -26,6 +26,7 @@
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
+#include <libevmasm/OptimiserPassManager.h>
 #include <libevmasm/GasMeter.h>
 
 #include <fstream>
@@ -114,10 +115,11 @@ public:
 
 	void feed(AssemblyItem const& _item)
 	{
-		if (!_item.location().isEmpty() && _item.location() != m_location)
+		if (!_item.location().isEmpty() && _item.location() != m_itemLocation)
 		{
 			flush();
-			m_location = _item.location();
+			m_itemLocation = _item.location();
+			m_location = _item.sourceLocation();
 			printLocation();
 		}
 		if (!(
@@ -171,6 +173,7 @@ public:
 
 private:
 	strings m_pending;
+	ItemLocation m_itemLocation;
 	SourceLocation m_location;
 
 	ostream& m_out;
@@ -256,7 +259,7 @@ Json::Value Assembly::streamAsmJson(ostream& _out, StringMap const& _sourceCodes
 					createJsonValue("PUSH [ErrorTag]", i.location().start, i.location().end, ""));
 			else
 				collection.append(
-					createJsonValue("PUSH [tag]", i.location().start, i.location().end, string(i.data())));
+					createJsonValue("PUSH [tag]", i.location().start, i.location().end, i.data().str()));
 			break;
 		case PushSub:
 			collection.append(
@@ -277,7 +280,7 @@ Json::Value Assembly::streamAsmJson(ostream& _out, StringMap const& _sourceCodes
 			break;
 		case Tag:
 			collection.append(
-				createJsonValue("tag", i.location().start, i.location().end, string(i.data())));
+				createJsonValue("tag", i.location().start, i.location().end, i.data().str()));
 			collection.append(
 				createJsonValue("JUMPDEST", i.location().start, i.location().end));
 			break;
@@ -347,86 +350,61 @@ void Assembly::injectStart(AssemblyItem const& _i)
 	m_items.insert(m_items.begin(), _i);
 }
 
-Assembly& Assembly::optimise(bool _enable, bool _isCreation, size_t _runs)
+Assembly& Assembly::optimise(bool _enable, bool _isCreation, size_t _runs, ThreadPool* _threadPool)
 {
-	optimiseInternal(_enable, _isCreation, _runs);
+	optimiseInternal(_enable, _isCreation, _runs, _threadPool, set<u256>());
 	return *this;
 }
 
-map<u256, u256> Assembly::optimiseInternal(bool _enable, bool _isCreation, size_t _runs)
+map<u256, u256> Assembly::optimiseInternal(
+	bool _enable,
+	bool _isCreation,
+	size_t _runs,
+	ThreadPool* _threadPool,
+	set<u256> const& _externalTags
+)
 {
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(_enable, false, _runs);
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
-
-	map<u256, u256> tagReplacements;
-	for (unsigned count = 1; count > 0;)
-	{
-		count = 0;
-
-		PeepholeOptimiser peepOpt(m_items);
-		while (peepOpt.optimise())
-			count++;
-
-		if (!_enable)
-			continue;
-
-		// This only modifies PushTags, we have to run again to actually remove code.
-		BlockDeduplicator dedup(m_items);
-		if (dedup.deduplicate())
-		{
-			tagReplacements.insert(dedup.replacedTags().begin(), dedup.replacedTags().end());
-			count++;
-		}
+	// An assembly that has already been assembled must not be modified anymore. This is the
+	// case for the code of other contracts that is included for contract creation and might be
+	// shared between several (possibly concurrently compiled) contracts.
+	// Optimising it again would not change the generated code: its bytecode is cached, and
+	// its tags are not pushed by the including assembly, so there are no replacements to apply.
+	if (!m_assembledObject.bytecode.empty())
+		return map<u256, u256>();
 
+	// The subs are independent of each other, unless the same assembly is used twice.
+	set<Assembly const*> distinctSubs;
+	for (auto const& sub: m_subs)
+		distinctSubs.insert(sub.get());
+	// Tags of subs that are pushed here (e.g. runtime functions stored in storage by the
+	// constructor) can be jumped to in the sub although it does not push them itself.
+	vector<set<u256>> subExternalTags(m_subs.size());
+	for (auto const& item: m_items)
+		if (item.type() == PushTag)
 		{
-			// Control flow graph optimization has been here before but is disabled because it
-			// assumes we only jump to tags that are pushed. This is not the case anymore with
-			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
-			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator(emptyState);
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end());
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
-				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
-				}
-
-				if (shouldReplace)
-				{
-					count++;
-					optimisedItems += optimisedChunk;
-				}
-				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
-			if (optimisedItems.size() < m_items.size())
+			size_t subId;
+			size_t tag;
+			tie(subId, tag) = item.splitForeignPushTag();
+			if (subId != size_t(-1))
 			{
-				m_items = move(optimisedItems);
-				count++;
+				assertThrow(subId < m_subs.size(), AssemblyException, "Invalid sub id.");
+				subExternalTags[subId].insert(tag);
 			}
 		}
-	}
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	OptimiserPassManager::parallelFor(
+		distinctSubs.size() == m_subs.size() ? _threadPool : nullptr,
+		m_subs.size(),
+		[&](size_t _subId)
+		{
+			subTagReplacements[_subId] =
+				m_subs[_subId]->optimiseInternal(_enable, false, _runs, _threadPool, subExternalTags[_subId]);
+		}
+	);
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
+
+	map<u256, u256> tagReplacements = OptimiserPassManager(m_items, _enable, _threadPool, _externalTags).run();
 
 	if (_enable)
 		ConstantOptimisationMethod::optimiseConstants(
@@ -448,8 +426,10 @@ LinkerObject const& Assembly::assemble() const
 	for (auto const& sub: m_subs)
 	{
 		sub->assemble();
-		if (!sub->m_tagPositionsInBytecode.empty())
-			subTagSize = max(subTagSize, *max_element(sub->m_tagPositionsInBytecode.begin(), sub->m_tagPositionsInBytecode.end()));
+		// Tags removed by the optimiser do not have a position.
+		for (size_t tagPosition: sub->m_tagPositionsInBytecode)
+			if (tagPosition != size_t(-1))
+				subTagSize = max(subTagSize, tagPosition);
 	}
 
 	LinkerObject& ret = m_assembledObject;
@@ -524,7 +504,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushSubSize:
 		{
 			auto s = m_subs.at(size_t(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			byte b = max<unsigned>(1, dev::bytesRequired(s));
 			ret.bytecode.push_back((byte)Instruction::PUSH1 - 1 + b);
 			ret.bytecode.resize(ret.bytecode.size() + b);
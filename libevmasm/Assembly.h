@@ -26,12 +26,14 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
 #include <libdevcore/SHA3.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <set>
 
 namespace dev
 {
@@ -102,7 +104,9 @@ public:
 	/// @a _runs specifes an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime.
 	/// If @a _enable is not set, will perform some simple peephole optimizations.
-	Assembly& optimise(bool _enable, bool _isCreation = true, size_t _runs = 200);
+	/// Independent blocks and sub-assemblies are optimised on the threads of @a _threadPool, if
+	/// given. The result does not depend on the number of threads.
+	Assembly& optimise(bool _enable, bool _isCreation = true, size_t _runs = 200, ThreadPool* _threadPool = nullptr);
 	Json::Value stream(
 		std::ostream& _out,
 		std::string const& _prefix = "",
@@ -113,7 +117,14 @@ public:
 protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags.
-	std::map<u256, u256> optimiseInternal(bool _enable, bool _isCreation, size_t _runs);
+	/// @param _externalTags tags of this assembly that are pushed by the parent assembly.
+	std::map<u256, u256> optimiseInternal(
+		bool _enable,
+		bool _isCreation,
+		size_t _runs,
+		ThreadPool* _threadPool,
+		std::set<u256> const& _externalTags
+	);
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -21,7 +21,11 @@
 
 #include "AssemblyItem.h"
 #include <libevmasm/SemanticInformation.h>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
@@ -50,6 +54,132 @@ void AssemblyItem::setPushTagSubIdAndTag(size_t _subId, size_t _tag)
 	setData(_tag + (u256(_subId + 1) << 64));
 }
 
+size_t AssemblyItem::hash() const
+{
+	size_t hash = 0;
+	boost::hash_combine(hash, unsigned(m_type));
+	if (m_type == Operation)
+		boost::hash_combine(hash, unsigned(m_instruction));
+	else
+	{
+		// Hashes the limbs directly, converting the value would be much slower.
+		auto const& data = m_data.backend();
+		boost::hash_range(hash, data.limbs(), data.limbs() + data.size());
+	}
+	return hash;
+}
+
+namespace
+{
+
+bool sameOwner(weak_ptr<string const> const& _a, shared_ptr<string const> const& _b)
+{
+	return !_a.owner_before(_b) && !_b.owner_before(_a);
+}
+
+/// Process-wide table of the source names of assembly items. It only holds weak references, the
+/// names belong to the scanners and AST nodes of their sources and are released with them.
+/// Numbers are not reused, so an item that outlives its source loses the name instead of
+/// getting another one.
+class SourceNames
+{
+public:
+	unsigned id(shared_ptr<string const> const& _name)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_ids.find(*_name);
+		if (it == m_ids.end())
+		{
+			if (m_ids.size() >= 2 * m_idsAfterSweep)
+				sweep();
+			m_names.emplace_back();
+			it = m_ids.insert(make_pair(*_name, unsigned(m_names.size()))).first;
+		}
+		// Several sources with the same name can exist at the same time, e.g. in different
+		// compiler stacks, and they can be released in any order.
+		vector<weak_ptr<string const>>& names = m_names[it->second - 1];
+		for (weak_ptr<string const> const& name: names)
+			if (sameOwner(name, _name))
+				return it->second;
+		names.push_back(_name);
+		return it->second;
+	}
+
+	shared_ptr<string const> name(unsigned _id)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (weak_ptr<string const> const& name: m_names.at(_id - 1))
+			if (auto alive = name.lock())
+				return alive;
+		return nullptr;
+	}
+
+private:
+	/// Removes the names that have been released.
+	void sweep()
+	{
+		for (auto it = m_ids.begin(); it != m_ids.end();)
+		{
+			vector<weak_ptr<string const>>& names = m_names[it->second - 1];
+			names.erase(
+				remove_if(names.begin(), names.end(), [](weak_ptr<string const> const& _n) { return _n.expired(); }),
+				names.end()
+			);
+			if (names.empty())
+			{
+				names.shrink_to_fit();
+				it = m_ids.erase(it);
+			}
+			else
+				++it;
+		}
+		m_idsAfterSweep = max<size_t>(m_ids.size(), 16);
+	}
+
+	mutex m_mutex;
+	unordered_map<string, unsigned> m_ids;
+	/// Names by number minus one.
+	vector<vector<weak_ptr<string const>>> m_names;
+	size_t m_idsAfterSweep = 16;
+};
+
+SourceNames& sourceNames()
+{
+	static SourceNames names;
+	return names;
+}
+
+}
+
+ItemLocation AssemblyItem::itemLocation(SourceLocation const& _location)
+{
+	ItemLocation location;
+	location.start = _location.start;
+	location.end = _location.end;
+	if (!_location.sourceName)
+		return location;
+	// Items are mostly created for the source that is currently compiled, so the last name
+	// is remembered per thread. The weak reference keeps the owner from being reused.
+	static thread_local weak_ptr<string const> lastName;
+	static thread_local unsigned lastID = 0;
+	if (!sameOwner(lastName, _location.sourceName))
+	{
+		lastID = sourceNames().id(_location.sourceName);
+		lastName = _location.sourceName;
+	}
+	location.sourceID = lastID;
+	return location;
+}
+
+SourceLocation AssemblyItem::sourceLocation() const
+{
+	return SourceLocation(
+		m_location.start,
+		m_location.end,
+		m_location.sourceID ? sourceNames().name(m_location.sourceID) : nullptr
+	);
+}
+
 unsigned AssemblyItem::bytesRequired(unsigned _addressLength) const
 {
 	switch (m_type)
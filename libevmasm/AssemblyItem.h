@@ -22,7 +22,9 @@
 #pragma once
 
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
 #include <libevmasm/Instruction.h>
@@ -51,27 +53,52 @@ enum AssemblyItemType {
 
 class Assembly;
 
+/**
+ * Source location of an assembly item. The source name is stored as its number in a process-wide
+ * table, so that the location can be copied like a plain value.
+ */
+struct ItemLocation
+{
+	bool isEmpty() const { return start == -1 && end == -1; }
+	bool operator==(ItemLocation const& _other) const
+	{
+		return start == _other.start && end == _other.end && sourceID == _other.sourceID;
+	}
+	bool operator!=(ItemLocation const& _other) const { return !operator==(_other); }
+
+	int start = -1;
+	int end = -1;
+	/// Number of the source name, zero if there is none.
+	unsigned sourceID = 0;
+};
+
 class AssemblyItem
 {
 public:
 	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
 
-	AssemblyItem(u256 _push, SourceLocation const& _location = SourceLocation()):
+	AssemblyItem(u256 _push, ItemLocation const& _location = ItemLocation()):
 		AssemblyItem(Push, _push, _location) { }
-	AssemblyItem(solidity::Instruction _i, SourceLocation const& _location = SourceLocation()):
+	AssemblyItem(solidity::Instruction _i, ItemLocation const& _location = ItemLocation()):
 		m_type(Operation),
 		m_instruction(_i),
 		m_location(_location)
 	{}
-	AssemblyItem(AssemblyItemType _type, u256 _data = 0, SourceLocation const& _location = SourceLocation()):
+	AssemblyItem(AssemblyItemType _type, u256 _data = 0, ItemLocation const& _location = ItemLocation()):
 		m_type(_type),
 		m_location(_location)
 	{
 		if (m_type == Operation)
 			m_instruction = Instruction(byte(_data));
 		else
-			m_data = std::make_shared<u256>(_data);
+			m_data = _data;
 	}
+	AssemblyItem(u256 _push, SourceLocation const& _location):
+		AssemblyItem(_push, itemLocation(_location)) { }
+	AssemblyItem(solidity::Instruction _i, SourceLocation const& _location):
+		AssemblyItem(_i, itemLocation(_location)) { }
+	AssemblyItem(AssemblyItemType _type, u256 _data, SourceLocation const& _location):
+		AssemblyItem(_type, _data, itemLocation(_location)) { }
 
 	AssemblyItem tag() const { assertThrow(m_type == PushTag || m_type == Tag, Exception, ""); return AssemblyItem(Tag, data()); }
 	AssemblyItem pushTag() const { assertThrow(m_type == PushTag || m_type == Tag, Exception, ""); return AssemblyItem(PushTag, data()); }
@@ -85,8 +112,8 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 const& data() const { assertThrow(m_type != Operation, Exception, ""); return m_data; }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, Exception, ""); m_data = _data; }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, Exception, ""); return m_instruction; }
@@ -112,6 +139,8 @@ public:
 		else
 			return data() < _other.data();
 	}
+	/// @returns a hash value compatible with operator==.
+	size_t hash() const;
 
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
@@ -123,29 +152,48 @@ public:
 	/// @returns true if the assembly item can be used in a functional context.
 	bool canBeFunctional() const;
 
-	void setLocation(SourceLocation const& _location) { m_location = _location; }
-	SourceLocation const& location() const { return m_location; }
+	void setLocation(ItemLocation const& _location) { m_location = _location; }
+	void setLocation(SourceLocation const& _location) { m_location = itemLocation(_location); }
+	ItemLocation const& location() const { return m_location; }
+	/// @returns the source location with the source name looked up in the table of names.
+	/// The name is not kept alive by the item, it is missing if its source no longer exists.
+	SourceLocation sourceLocation() const;
 
 	void setJumpType(JumpType _jumpType) { m_jumpType = _jumpType; }
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const
+	{
+		assertThrow(_value <= std::numeric_limits<unsigned>::max(), Exception, "Code too large.");
+		m_pushedValue = unsigned(_value);
+		m_hasPushedValue = true;
+	}
+	bool hasPushedValue() const { return m_hasPushedValue; }
+	size_t pushedValue() const { return m_pushedValue; }
 
 	std::string toAssemblyText() const;
 
 private:
+	/// @returns the location @a _location with its source name replaced by its number. Equal names
+	/// get the same number as long as one of them is alive.
+	static ItemLocation itemLocation(SourceLocation const& _location);
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	SourceLocation m_location;
+	mutable bool m_hasPushedValue = false;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// Stored in place, most values are small and allocating them is more expensive than copying.
+	u256 m_data; ///< Only valid if m_type != Operation
+	ItemLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
-	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	/// e.g. PushSubSize, PushTag, PushSub, etc. Code sizes fit into 32 bits.
+	mutable unsigned m_pushedValue = 0;
 };
 
+// Only the copy constructor of u256 keeps items from being trivially copyable.
+static_assert(std::is_trivially_destructible<AssemblyItem>::value, "Assembly items should not own resources.");
+
 using AssemblyItems = std::vector<AssemblyItem>;
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
@@ -22,7 +22,9 @@
  */
 
 #include <libevmasm/BlockDeduplicator.h>
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
@@ -30,10 +32,96 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+/**
+ * Polynomial hashes of the blocks that start at the tags of an assembly. The hash of a block
+ * covers the items after its tag, ignoring tags and stopping after opcodes that stop the
+ * control flow, where pushes of the block's own tag are replaced by a virtual tag.
+ * Prefix hashes make it possible to compute the hash of every block in constant time plus
+ * the number of pushes of its own tag, even if blocks fall through into each other.
+ */
+class BlockHasher
+{
+public:
+	BlockHasher(AssemblyItems const& _items, AssemblyItem const& _pushSelf):
+		m_items(_items),
+		m_pushSelfHash(_pushSelf.hash())
+	{
+		size_t size = _items.size();
+		m_prefix.resize(size + 1, 0);
+		m_count.resize(size + 1, 0);
+		m_powers.resize(size + 1, 1);
+		m_blockEnd.resize(size + 1, size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			m_powers[i + 1] = m_powers[i] * c_base;
+			if (_items[i].type() == Tag)
+			{
+				m_prefix[i + 1] = m_prefix[i];
+				m_count[i + 1] = m_count[i];
+			}
+			else
+			{
+				m_prefix[i + 1] = m_prefix[i] * c_base + _items[i].hash();
+				m_count[i + 1] = m_count[i] + 1;
+			}
+			if (_items[i].type() == PushTag)
+				m_pushTagPositions[_items[i].data()].push_back(i);
+		}
+		for (size_t i = size; i > 0; --i)
+			if (
+				SemanticInformation::altersControlFlow(_items[i - 1]) &&
+				_items[i - 1] != AssemblyItem(Instruction::JUMPI)
+			)
+				m_blockEnd[i - 1] = i;
+			else
+				m_blockEnd[i - 1] = m_blockEnd[i];
+	}
+
+	/// @returns the hash of the block starting at the tag at position @a _tag.
+	uint64_t blockHash(size_t _tag) const
+	{
+		size_t begin = _tag + 1;
+		size_t end = m_blockEnd[begin];
+		uint64_t hash = m_prefix[end] - m_prefix[begin] * m_powers[m_count[end] - m_count[begin]];
+		auto pushes = m_pushTagPositions.find(m_items[_tag].data());
+		if (pushes != m_pushTagPositions.end())
+		{
+			auto const& positions = pushes->second;
+			for (
+				auto it = lower_bound(positions.begin(), positions.end(), begin);
+				it != positions.end() && *it < end;
+				++it
+			)
+				hash += (m_pushSelfHash - m_items[*it].hash()) * m_powers[m_count[end] - m_count[*it] - 1];
+		}
+		return hash;
+	}
+
+private:
+	/// Odd multiplier, arithmetic is modulo 2**64.
+	static uint64_t const c_base = 0x100000001b3;
+
+	AssemblyItems const& m_items;
+	uint64_t m_pushSelfHash;
+	/// Hash of the non-tag items before each position.
+	std::vector<uint64_t> m_prefix;
+	/// Number of non-tag items before each position.
+	std::vector<size_t> m_count;
+	std::vector<uint64_t> m_powers;
+	/// Position after the item that ends the block containing each position.
+	std::vector<size_t> m_blockEnd;
+	std::map<u256, std::vector<size_t>> m_pushTagPositions;
+};
+
+}
+
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
+	// Compares blocks based on the items that follow their tag, ignoring tags and stopping at
 	// opcodes that stop the control flow.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
@@ -45,45 +133,22 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
-	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag(pushSelf);
-		AssemblyItem pushSecondTag(pushSelf);
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		BlockIterator first(m_items.begin() + _i, m_items.end(), &pushFirstTag, &pushSelf);
-		BlockIterator second(m_items.begin() + _j, m_items.end(), &pushSecondTag, &pushSelf);
-		BlockIterator end(m_items.end(), m_items.end());
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
-	};
-
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		BlockHasher hasher(m_items, pushSelf);
+		// Positions of the first tag of each distinct block, by hash.
+		unordered_map<uint64_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[hasher.blockHash(i)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) {
+				return blocksEqual(_j, i, pushSelf);
+			});
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -94,6 +159,26 @@ bool BlockDeduplicator::deduplicate()
 	return iterations > 0;
 }
 
+bool BlockDeduplicator::blocksEqual(size_t _i, size_t _j, AssemblyItem const& _pushSelf) const
+{
+	// To compare recursive loops, we have to already unify PushTag opcodes of the
+	// block's own tag.
+	AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+	AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
+
+	BlockIterator first(m_items.begin() + _i, m_items.end(), &pushFirstTag, &_pushSelf);
+	BlockIterator second(m_items.begin() + _j, m_items.end(), &pushSecondTag, &_pushSelf);
+	BlockIterator end(m_items.end(), m_items.end());
+
+	// Skip the tags themselves.
+	++first;
+	++second;
+	for (; first != end && second != end; ++first, ++second)
+		if (*first != *second)
+			return false;
+	return first == end && second == end;
+}
+
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
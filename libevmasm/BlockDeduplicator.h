@@ -62,6 +62,10 @@ public:
 	);
 
 private:
+	/// @returns true if the blocks starting at the tags at positions @a _i and @a _j have
+	/// the same content, where pushes of their own tags are replaced by @a _pushSelf.
+	bool blocksEqual(size_t _i, size_t _j, AssemblyItem const& _pushSelf) const;
+
 	/// Iterator that skips tags and skips to the end if (all branches of) the control
 	/// flow does not continue to the next instruction.
 	/// If the arguments are supplied to the constructor, replaces items on the fly.
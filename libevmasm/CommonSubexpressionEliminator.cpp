@@ -54,9 +54,9 @@ vector<AssemblyItem> CommonSubexpressionEliminator::getOptimizedItems()
 	if (!m_state.stackElements().empty())
 		minHeight = min(minHeight, m_state.stackElements().begin()->first);
 	for (int height = minHeight; height <= m_initialState.stackHeight(); ++height)
-		initialStackContents[height] = m_initialState.stackElement(height, SourceLocation());
+		initialStackContents[height] = m_initialState.stackElement(height, ItemLocation());
 	for (int height = minHeight; height <= m_state.stackHeight(); ++height)
-		targetStackContents[height] = m_state.stackElement(height, SourceLocation());
+		targetStackContents[height] = m_state.stackElement(height, ItemLocation());
 
 	AssemblyItems items = CSECodeGenerator(m_state.expressionClasses(), m_storeOperations).generateCode(
 		m_initialState.sequenceNumber(),
@@ -83,7 +83,7 @@ void CommonSubexpressionEliminator::optimizeBreakingItem()
 		return;
 
 	ExpressionClasses& classes = m_state.expressionClasses();
-	SourceLocation const& itemLocation = m_breakingItem->location();
+	ItemLocation const& itemLocation = m_breakingItem->location();
 	if (*m_breakingItem == AssemblyItem(Instruction::JUMPI))
 	{
 		AssemblyItem::JumpType jumpType = m_breakingItem->getJumpType();
@@ -179,7 +179,7 @@ AssemblyItems CSECodeGenerator::generateCode(
 		assertThrow(!m_classPositions[targetItem.second].empty(), OptimizerException, "");
 		if (m_classPositions[targetItem.second].count(targetItem.first))
 			continue;
-		SourceLocation sourceLocation;
+		ItemLocation sourceLocation;
 		if (m_expressionClasses.representative(targetItem.second).item)
 			sourceLocation = m_expressionClasses.representative(targetItem.second).item->location();
 		int position = classElementPosition(targetItem.second);
@@ -334,7 +334,7 @@ void CSECodeGenerator::generateClassElement(Id _c, bool _allowSequenced)
 	for (Id arg: boost::adaptors::reverse(arguments))
 		generateClassElement(arg);
 
-	SourceLocation const& itemLocation = expr.item->location();
+	ItemLocation const& itemLocation = expr.item->location();
 	// The arguments are somewhere on the stack now, so it remains to move them at the correct place.
 	// This is quite difficult as sometimes, the values also have to removed in this process
 	// (if canBeRemoved() returns true) and the two arguments can be equal. For now, this is
@@ -463,7 +463,7 @@ bool CSECodeGenerator::removeStackTopIfPossible()
 	return true;
 }
 
-void CSECodeGenerator::appendDup(int _fromPosition, SourceLocation const& _location)
+void CSECodeGenerator::appendDup(int _fromPosition, ItemLocation const& _location)
 {
 	assertThrow(_fromPosition != c_invalidPosition, OptimizerException, "");
 	int instructionNum = 1 + m_stackHeight - _fromPosition;
@@ -474,7 +474,7 @@ void CSECodeGenerator::appendDup(int _fromPosition, SourceLocation const& _locat
 	m_classPositions[m_stack[m_stackHeight]].insert(m_stackHeight);
 }
 
-void CSECodeGenerator::appendOrRemoveSwap(int _fromPosition, SourceLocation const& _location)
+void CSECodeGenerator::appendOrRemoveSwap(int _fromPosition, ItemLocation const& _location)
 {
 	assertThrow(_fromPosition != c_invalidPosition, OptimizerException, "");
 	if (_fromPosition == m_stackHeight)
@@ -22,10 +22,50 @@
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
+namespace
+{
+
+/// Representations found by ComputeMethod, keyed by the parameters that influence the search
+/// (isCreation, runs, multiplicity) and the value.
+using RepresentationKey = tuple<bool, size_t, size_t, u256>;
+
+/// Upper bound on the number of entries, further representations are not remembered.
+size_t const c_maxCachedRepresentations = 0x10000;
+
+struct RepresentationCache
+{
+	mutex entriesMutex;
+	map<RepresentationKey, AssemblyItems> entries;
+
+	static RepresentationCache& instance()
+	{
+		static RepresentationCache cache;
+		return cache;
+	}
+
+	void insert(RepresentationKey const& _key, AssemblyItems const& _routine)
+	{
+		lock_guard<mutex> lock(entriesMutex);
+		if (entries.size() < c_maxCachedRepresentations)
+			entries.insert(make_pair(_key, _routine));
+	}
+};
+
+RepresentationKey representationKey(ConstantOptimisationMethod::Params const& _params, u256 const& _value)
+{
+	return make_tuple(_params.isCreation, _params.runs, _params.multiplicity, _value);
+}
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -177,19 +217,58 @@ AssemblyItems const& CodeCopyMethod::copyRoutine() const
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	RepresentationKey key = representationKey(m_params, m_value);
+	RepresentationCache& cache = RepresentationCache::instance();
+	{
+		lock_guard<mutex> lock(cache.entriesMutex);
+		auto it = cache.entries.find(key);
+		if (it != cache.entries.end())
+		{
+			// Entries were checked when they were added.
+			m_routine = it->second;
+			return;
+		}
+	}
+
+	m_routine = findRepresentation(m_value);
+	m_partialRepresentations.clear();
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+	cache.insert(key, m_routine);
+}
+
+void ComputeMethod::clearCache()
+{
+	RepresentationCache& cache = RepresentationCache::instance();
+	lock_guard<mutex> lock(cache.entriesMutex);
+	cache.entries.clear();
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
 		// Very small value, not worth computing
 		return AssemblyItems{_value};
-	else if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
+
+	auto known = m_partialRepresentations.find(_value);
+	if (known != m_partialRepresentations.end())
+		return known->second;
+
+	AssemblyItems routine;
+	if (dev::bytesRequired(~_value) < dev::bytesRequired(_value))
 		// Negated is shorter to represent
-		return findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
+		routine = findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
 	else
 	{
 		// Decompose value into a * 2**k + b where abs(b) << 2**k
 		// Is not always better, try literal and decomposition method.
-		AssemblyItems routine{u256(_value)};
+		routine = AssemblyItems{u256(_value)};
 		bigint bestGas = gasNeeded(routine);
 		for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
 		{
@@ -230,8 +309,9 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 				routine = move(newRoutine);
 			}
 		}
-		return routine;
 	}
+	m_partialRepresentations[_value] = routine;
+	return routine;
 }
 
 bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const& _routine)
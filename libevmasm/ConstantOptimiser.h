@@ -21,12 +21,14 @@
 
 #pragma once
 
+#include <libevmasm/AssemblyItem.h>
 #include <libevmasm/Exceptions.h>
 
 #include <libdevcore/Assertions.h>
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 
+#include <map>
 #include <vector>
 
 namespace dev
@@ -34,8 +36,6 @@ namespace dev
 namespace eth
 {
 
-class AssemblyItem;
-using AssemblyItems = std::vector<AssemblyItem>;
 class Assembly;
 
 /**
@@ -126,20 +126,15 @@ protected:
 
 /**
  * Method that tries to compute the constant.
+ * The representations found are kept in a table shared by all instances (and threads), keyed by
+ * the value and the parameters, so that constants that appear in several assemblies or
+ * compilations are only searched for once. It only contains the results of the search, so the
+ * representation of a constant does not depend on earlier compilations.
  */
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
 
 	virtual bigint gasNeeded() override { return gasNeeded(m_routine); }
 	virtual AssemblyItems execute(Assembly&) override
@@ -147,15 +142,21 @@ public:
 		return m_routine;
 	}
 
+	/// Removes all representations from the table.
+	static void clearCache();
+
 protected:
 	/// Tries to recursively find a way to compute @a _value.
 	AssemblyItems findRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
-	bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine);
+	static bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine);
 	bigint gasNeeded(AssemblyItems const& _routine);
 
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
+	/// Representations of the parts of the value that were already searched for. Only valid
+	/// during the search for a single value, so the result does not depend on earlier searches.
+	std::map<u256, AssemblyItems> m_partialRepresentations;
 	AssemblyItems m_routine;
 };
 
@@ -40,12 +40,25 @@ BlockId::BlockId(u256 const& _id):
 	assertThrow( _id < initial().m_id, OptimizerException, "Tag number too large.");
 }
 
+ControlFlowGraph::ControlFlowGraph(
+	AssemblyItems const& _items,
+	bool _joinKnowledge,
+	set<u256> const& _externalTags
+):
+	m_items(_items),
+	m_joinKnowledge(_joinKnowledge)
+{
+	for (u256 const& tag: _externalTags)
+		m_externalTags.insert(BlockId(tag));
+}
+
 BasicBlocks ControlFlowGraph::optimisedBlocks()
 {
 	if (m_items.empty())
 		return BasicBlocks();
 
 	findLargestTag();
+	findEscapingTags();
 	splitBlocks();
 	resolveNextLinks();
 	removeUnusedBlocks();
@@ -55,11 +68,16 @@ BasicBlocks ControlFlowGraph::optimisedBlocks()
 	return rebuildCode();
 }
 
+bool ControlFlowGraph::isForeignPushTag(AssemblyItem const& _item)
+{
+	return _item.type() == PushTag && _item.splitForeignPushTag().first != size_t(-1);
+}
+
 void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
 	for (auto const& item: m_items)
-		if (item.type() == Tag || item.type() == PushTag)
+		if ((item.type() == Tag || item.type() == PushTag) && !isForeignPushTag(item))
 		{
 			// Assert that it can be converted.
 			BlockId(item.data());
@@ -67,6 +85,23 @@ void ControlFlowGraph::findLargestTag()
 		}
 }
 
+void ControlFlowGraph::findEscapingTags()
+{
+	m_escapingTags = m_externalTags;
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items.at(index);
+		if (item.type() != PushTag || isForeignPushTag(item))
+			continue;
+		// A tag that is consumed by the next instruction as jump target does not leave the stack.
+		bool jumpedTo =
+			index + 1 < m_items.size() &&
+			(m_items[index + 1] == Instruction::JUMP || m_items[index + 1] == Instruction::JUMPI);
+		if (!jumpedTo)
+			m_escapingTags.insert(BlockId(item.data()));
+	}
+}
+
 void ControlFlowGraph::splitBlocks()
 {
 	m_blocks.clear();
@@ -86,7 +121,7 @@ void ControlFlowGraph::splitBlocks()
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
 			m_blocks[id].begin = index;
 		}
-		if (item.type() == PushTag)
+		if (item.type() == PushTag && !isForeignPushTag(item))
 			m_blocks[id].pushedTags.push_back(BlockId(item.data()));
 		if (SemanticInformation::altersControlFlow(item))
 		{
@@ -139,6 +174,12 @@ void ControlFlowGraph::removeUnusedBlocks()
 {
 	vector<BlockId> blocksToProcess{BlockId::initial()};
 	set<BlockId> neededBlocks{BlockId::initial()};
+	for (BlockId tag: m_externalTags)
+		if (m_blocks.count(tag))
+		{
+			neededBlocks.insert(tag);
+			blocksToProcess.push_back(tag);
+		}
 	while (!blocksToProcess.empty())
 	{
 		BasicBlock const& block = m_blocks.at(blocksToProcess.back());
@@ -190,7 +231,7 @@ void ControlFlowGraph::setPrevLinks()
 		if (block.endType != BasicBlock::EndType::JUMP || block.end - block.begin < 2)
 			continue;
 		AssemblyItem const& push = m_items.at(block.end - 2);
-		if (push.type() != PushTag)
+		if (push.type() != PushTag || isForeignPushTag(push))
 			continue;
 		BlockId nextId(push.data());
 		if (m_blocks.count(nextId) && m_blocks.at(nextId).prev)
@@ -238,8 +279,25 @@ void ControlFlowGraph::gatherKnowledge()
 		workQueue.push_back(move(item));
 	};
 
-	while (!workQueue.empty())
+	// We do not know the target of jumps whose target is not known, so we have to reset the
+	// states of all escaping tags.
+	auto addEscapingTags = [&]()
 	{
+		unknownJumpEncountered = true;
+		for (BlockId tag: m_escapingTags)
+			if (m_blocks.count(tag))
+				workQueue.push_back(WorkQueueItem{tag, emptyState->copy(), set<BlockId>()});
+	};
+
+	while (!workQueue.empty() || !unknownJumpEncountered)
+	{
+		if (workQueue.empty())
+		{
+			// Escaping tags have to be kept even if there is no jump they could be the target of,
+			// because they are still pushed.
+			addEscapingTags();
+			continue;
+		}
 		WorkQueueItem item = move(workQueue.back());
 		workQueue.pop_back();
 		//@todo we might have to do something like incrementing the sequence number for each JUMPDEST
@@ -275,21 +333,18 @@ void ControlFlowGraph::gatherKnowledge()
 			//@todo in the case of JUMPI, add knowledge about the condition to the state
 			// (for both values of the condition)
 			set<u256> tags = state->tagsInExpression(
-				state->stackElement(state->stackHeight(), SourceLocation())
+				state->stackElement(state->stackHeight(), ItemLocation())
 			);
 			state->feedItem(m_items.at(pc++));
 
+			// Tags of other assemblies are not valid jump targets, treat them as unknown.
+			if (any_of(tags.begin(), tags.end(), [](u256 const& _tag) { return _tag >= (u256(1) << 64); }))
+				tags.clear();
+
 			if (tags.empty())
 			{
 				if (!unknownJumpEncountered)
-				{
-					// We do not know the target of this jump, so we have to reset the states of all
-					// JUMPDESTs.
-					unknownJumpEncountered = true;
-					for (auto const& it: m_blocks)
-						if (it.second.begin < it.second.end && m_items[it.second.begin].type() == Tag)
-							workQueue.push_back(WorkQueueItem{it.first, emptyState->copy(), set<BlockId>()});
-				}
+					addEscapingTags();
 			}
 			else
 				for (auto tag: tags)
@@ -325,6 +380,8 @@ BasicBlocks ControlFlowGraph::rebuildCode()
 		for (BlockId ref: idAndBlock.second.pushedTags)
 			if (m_blocks.count(ref))
 				pushes[ref]++;
+	for (BlockId tag: m_externalTags)
+		pushes[tag]++;
 
 	set<BlockId> blocksToAdd;
 	for (auto it: m_blocks)
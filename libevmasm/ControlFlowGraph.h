@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <memory>
+#include <set>
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
 #include <libevmasm/ExpressionClasses.h>
@@ -91,8 +92,10 @@ using BasicBlocks = std::vector<BasicBlock>;
 
 /**
  * Control flow graph optimizer.
- * ASSUMES THAT WE ONLY JUMP TO TAGS THAT WERE PREVIOUSLY PUSHED. THIS IS NOT TRUE ANYMORE
- * NOW THAT FUNCTION TAGS CAN BE STORED IN STORAGE.
+ * A jump whose target is not known can only go to a tag that escapes, i.e. a tag that is
+ * pushed but not immediately jumped to (it is stored, returned to or combined with other
+ * values) or a tag that is pushed by another assembly. Such jumps are assumed to reach all
+ * escaping tags.
  */
 class ControlFlowGraph
 {
@@ -100,16 +103,23 @@ public:
 	/// Initializes the control flow graph.
 	/// @a _items has to persist across the usage of this class.
 	/// @a _joinKnowledge if true, reduces state knowledge to common base at the join of two paths
-	explicit ControlFlowGraph(AssemblyItems const& _items, bool _joinKnowledge = true):
-		m_items(_items),
-		m_joinKnowledge(_joinKnowledge)
-	{}
+	/// @a _externalTags tags of this assembly that are pushed by other assemblies, e.g. runtime
+	/// functions that are stored in storage by the constructor.
+	explicit ControlFlowGraph(
+		AssemblyItems const& _items,
+		bool _joinKnowledge = true,
+		std::set<u256> const& _externalTags = std::set<u256>()
+	);
 	/// @returns vector of basic blocks in the order they should be used in the final code.
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
 
+	/// @returns true if @a _item pushes a tag of a sub-assembly.
+	static bool isForeignPushTag(AssemblyItem const& _item);
+
 private:
 	void findLargestTag();
+	void findEscapingTags();
 	void splitBlocks();
 	void resolveNextLinks();
 	void removeUnusedBlocks();
@@ -122,6 +132,10 @@ private:
 	unsigned m_lastUsedId = 0;
 	AssemblyItems const& m_items;
 	bool m_joinKnowledge = true;
+	/// Tags pushed by other assemblies.
+	std::set<BlockId> m_externalTags;
+	/// Tags that might be the target of jumps whose target is not known, includes m_externalTags.
+	std::set<BlockId> m_escapingTags;
 	std::map<BlockId, BasicBlock> m_blocks;
 };
 
@@ -27,6 +27,7 @@
 #include <functional>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
@@ -36,23 +37,36 @@ using namespace dev;
 using namespace dev::eth;
 
 
-bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression const& _other) const
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
 {
 	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (hash != _other.hash)
+		return false;
 	auto type = item->type();
-	auto otherType = _other.item->type();
-	if (type != otherType)
-		return type < otherType;
+	if (type != _other.item->type() || sequenceNumber != _other.sequenceNumber || arguments != _other.arguments)
+		return false;
 	else if (type == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+void ExpressionClasses::computeHash(Expression& _expression)
+{
+	size_t hash = 0;
+	AssemblyItemType type = _expression.item->type();
+	boost::hash_combine(hash, unsigned(type));
+	if (type == Operation)
+		boost::hash_combine(hash, unsigned(_expression.item->instruction()));
+	else
 	{
-		auto instr = item->instruction();
-		auto otherInstr = _other.item->instruction();
-		return std::tie(instr, arguments, sequenceNumber) <
-			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
+		// Hashes the limbs directly, converting the value would be much slower.
+		auto const& data = _expression.item->data().backend();
+		boost::hash_range(hash, data.limbs(), data.limbs() + data.size());
 	}
-	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+	boost::hash_range(hash, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(hash, _expression.sequenceNumber);
+	_expression.hash = hash;
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -70,6 +84,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	computeHash(exp);
 
 	if (SemanticInformation::isDeterministic(_item))
 	{
@@ -107,6 +122,7 @@ void ExpressionClasses::forceEqual(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	computeHash(exp);
 
 	if (_copyItem)
 		exp.item = storeItem(_item);
@@ -114,11 +130,12 @@ void ExpressionClasses::forceEqual(
 	m_expressions.insert(exp);
 }
 
-ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _location)
+ExpressionClasses::Id ExpressionClasses::newClass(ItemLocation const& _location)
 {
 	Expression exp;
 	exp.id = m_representatives.size();
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
+	computeHash(exp);
 	m_representatives.push_back(exp);
 	m_expressions.insert(exp);
 	return exp.id;
@@ -183,8 +200,6 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr, bool _secondRun)
 {
-	static Rules rules;
-
 	if (
 		!_expr.item ||
 		_expr.item->type() != Operation ||
@@ -192,7 +207,7 @@ ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr,
 	)
 		return -1;
 
-	if (auto match = rules.findFirstMatch(_expr, *this))
+	if (auto match = Rules::instance().findFirstMatch(_expr, *this))
 	{
 		// Debug info
 		//cout << "Simplifying " << *_expr.item << "(";
@@ -26,6 +26,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <unordered_set>
 #include <libdevcore/Common.h>
 #include <libevmasm/AssemblyItem.h>
 
@@ -54,8 +55,11 @@ public:
 		Ids arguments;
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
+		/// Hash of (item->type(), item->data(), arguments, sequenceNumber), set by @a ExpressionClasses
+		/// before the expression is looked up.
+		size_t hash = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
-		bool operator<(Expression const& _other) const;
+		bool operator==(Expression const& _other) const;
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -80,7 +84,7 @@ public:
 	void forceEqual(Id _id, AssemblyItem const& _item, Ids const& _arguments, bool _copyItem = true);
 
 	/// @returns the id of a new class which is different to all other classes.
-	Id newClass(SourceLocation const& _location);
+	Id newClass(ItemLocation const& _location);
 
 	/// @returns true if the values of the given classes are known to be different (on every input).
 	/// @note that this function might still return false for some different inputs.
@@ -114,10 +118,17 @@ private:
 
 	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
 
+	struct ExpressionHash
+	{
+		size_t operator()(Expression const& _expression) const { return _expression.hash; }
+	};
+	/// Sets the hash of @a _expression from its other fields.
+	static void computeHash(Expression& _expression);
+
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
@@ -92,9 +92,9 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 	else if (_item.type() != Operation)
 	{
 		assertThrow(_item.deposit() == 1, InvalidDeposit, "");
-		if (_item.pushedValue())
+		if (_item.hasPushedValue())
 			// only available after assembly stage, should not be used for optimisation
-			setStackElement(++m_stackHeight, m_expressionClasses->find(*_item.pushedValue()));
+			setStackElement(++m_stackHeight, m_expressionClasses->find(u256(_item.pushedValue())));
 		else
 			setStackElement(++m_stackHeight, m_expressionClasses->find(_item, {}, _copyItem));
 	}
@@ -223,6 +223,33 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
 
+KnownState KnownState::constantKnowledge() const
+{
+	KnownState state;
+	state.m_stackHeight = m_stackHeight;
+	for (auto const& stackElement: m_stackElements)
+		if (u256 const* value = m_expressionClasses->knownConstant(stackElement.second))
+			state.m_stackElements[stackElement.first] = state.m_expressionClasses->find(AssemblyItem(
+				*value,
+				m_expressionClasses->representative(stackElement.second).item->location()
+			));
+	// Storage and memory contents are only kept if both the slot and the value are constants.
+	auto copyConstantContent = [&](map<Id, Id> const& _from, map<Id, Id>& _to)
+	{
+		for (auto const& slotAndValue: _from)
+		{
+			u256 const* slot = m_expressionClasses->knownConstant(slotAndValue.first);
+			u256 const* value = m_expressionClasses->knownConstant(slotAndValue.second);
+			if (slot && value)
+				_to[state.m_expressionClasses->find(AssemblyItem(*slot))] =
+					state.m_expressionClasses->find(AssemblyItem(*value));
+		}
+	};
+	copyConstantContent(m_storageContent, state.m_storageContent);
+	copyConstantContent(m_memoryContent, state.m_memoryContent);
+	return state;
+}
+
 bool KnownState::operator==(KnownState const& _other) const
 {
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
@@ -236,7 +263,7 @@ bool KnownState::operator==(KnownState const& _other) const
 	return (thisIt == m_stackElements.cend() && otherIt == _other.m_stackElements.cend());
 }
 
-ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation const& _location)
+ExpressionClasses::Id KnownState::stackElement(int _stackHeight, ItemLocation const& _location)
 {
 	if (m_stackElements.count(_stackHeight))
 		return m_stackElements.at(_stackHeight);
@@ -245,7 +272,7 @@ ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation
 			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
 }
 
-KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation const& _location)
+KnownState::Id KnownState::relativeStackElement(int _stackOffset, ItemLocation const& _location)
 {
 	return stackElement(m_stackHeight + _stackOffset, _location);
 }
@@ -267,7 +294,7 @@ void KnownState::setStackElement(int _stackHeight, Id _class)
 void KnownState::swapStackElements(
 	int _stackHeightA,
 	int _stackHeightB,
-	SourceLocation const& _location
+	ItemLocation const& _location
 )
 {
 	assertThrow(_stackHeightA != _stackHeightB, OptimizerException, "Swap on same stack elements.");
@@ -281,7 +308,7 @@ void KnownState::swapStackElements(
 KnownState::StoreOperation KnownState::storeInStorage(
 	Id _slot,
 	Id _value,
-	SourceLocation const& _location)
+	ItemLocation const& _location)
 {
 	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
 		// do not execute the storage if we know that the value is already there
@@ -306,7 +333,7 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	return operation;
 }
 
-ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
+ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, ItemLocation const& _location)
 {
 	if (m_storageContent.count(_slot))
 		return m_storageContent.at(_slot);
@@ -315,7 +342,7 @@ ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const
 	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
-KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
+KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, ItemLocation const& _location)
 {
 	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
 		// do not execute the store if we know that the value is already there
@@ -337,7 +364,7 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 	return operation;
 }
 
-ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
+ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, ItemLocation const& _location)
 {
 	if (m_memoryContent.count(_slot))
 		return m_memoryContent.at(_slot);
@@ -349,7 +376,7 @@ ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const&
 KnownState::Id KnownState::applyKeccak256(
 	Id _start,
 	Id _length,
-	SourceLocation const& _location
+	ItemLocation const& _location
 )
 {
 	AssemblyItem keccak256Item(Instruction::KECCAK256, _location);
@@ -403,7 +430,7 @@ KnownState::Id KnownState::tagUnion(set<u256> _tags)
 		return m_tagUnions.right.at(_tags);
 	else
 	{
-		Id id = m_expressionClasses->newClass(SourceLocation());
+		Id id = m_expressionClasses->newClass(ItemLocation());
 		m_tagUnions.right.insert(make_pair(_tags, id));
 		return id;
 	}
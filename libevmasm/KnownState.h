@@ -109,15 +109,21 @@ public:
 
 	/// @returns a shared pointer to a copy of this state.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
+	/// @returns a state with new expression classes that only knows the stack height, the
+	/// stack elements that are known constants and the storage and memory slots at constant
+	/// addresses that are known to contain constants. The classes of other values refer to the
+	/// values at the start of the analysis and cannot be used to optimise code that starts at a
+	/// different position.
+	KnownState constantKnowledge() const;
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
 	bool operator==(KnownState const& _other) const;
 
 	/// Retrieves the current equivalence class fo the given stack element (or generates a new
 	/// one if it does not exist yet).
-	Id stackElement(int _stackHeight, SourceLocation const& _location);
+	Id stackElement(int _stackHeight, ItemLocation const& _location);
 	/// @returns the stackElement relative to the current stack height.
-	Id relativeStackElement(int _stackOffset, SourceLocation const& _location = SourceLocation());
+	Id relativeStackElement(int _stackOffset, ItemLocation const& _location = ItemLocation());
 
 	/// @returns its set of tags if the given expression class is a known tag union; returns a set
 	/// containing the tag if it is a PushTag expression and the empty set otherwise.
@@ -131,27 +137,28 @@ public:
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
 	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& memoryContent() const { return m_memoryContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
 	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
-	void swapStackElements(int _stackHeightA, int _stackHeightB, SourceLocation const& _location);
+	void swapStackElements(int _stackHeightA, int _stackHeightB, ItemLocation const& _location);
 
 	/// Increments the sequence number, deletes all storage information that might be overwritten
 	/// and stores the new value at the given slot.
 	/// @returns the store operation, which might be invalid if storage was not modified
-	StoreOperation storeInStorage(Id _slot, Id _value, SourceLocation const& _location);
+	StoreOperation storeInStorage(Id _slot, Id _value, ItemLocation const& _location);
 	/// Retrieves the current value at the given slot in storage or creates a new special sload class.
-	Id loadFromStorage(Id _slot, SourceLocation const& _location);
+	Id loadFromStorage(Id _slot, ItemLocation const& _location);
 	/// Increments the sequence number, deletes all memory information that might be overwritten
 	/// and stores the new value at the given slot.
 	/// @returns the store operation, which might be invalid if memory was not modified
-	StoreOperation storeInMemory(Id _slot, Id _value, SourceLocation const& _location);
+	StoreOperation storeInMemory(Id _slot, Id _value, ItemLocation const& _location);
 	/// Retrieves the current value at the given slot in memory or creates a new special mload class.
-	Id loadFromMemory(Id _slot, SourceLocation const& _location);
+	Id loadFromMemory(Id _slot, ItemLocation const& _location);
 	/// Finds or creates a new expression that applies the Keccak-256 hash function to the contents in memory.
-	Id applyKeccak256(Id _start, Id _length, SourceLocation const& _location);
+	Id applyKeccak256(Id _start, Id _length, ItemLocation const& _location);
 
 	/// @returns a new or already used Id representing the given set of tags.
 	Id tagUnion(std::set<u256> _tags);
@@ -0,0 +1,334 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file OptimiserPassManager.cpp
+ * @date 2017
+ * Runs the optimisation passes on the items of an assembly until they do not change anymore.
+ */
+
+#include <libevmasm/OptimiserPassManager.h>
+
+#include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/CommonSubexpressionEliminator.h>
+#include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+/// @returns a hash of the items between @a _begin and @a _end that is compatible with the
+/// equality of assembly items.
+size_t hashItems(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+{
+	size_t hash = 0;
+	for (auto it = _begin; it != _end; ++it)
+		boost::hash_combine(hash, it->hash());
+	return hash;
+}
+
+/// Adds the time spent in its scope to @a _milliseconds.
+class ScopeTimer
+{
+public:
+	explicit ScopeTimer(double& _milliseconds): m_milliseconds(_milliseconds), m_start(chrono::steady_clock::now()) {}
+	~ScopeTimer()
+	{
+		m_milliseconds += chrono::duration<double, milli>(chrono::steady_clock::now() - m_start).count();
+	}
+
+private:
+	double& m_milliseconds;
+	chrono::steady_clock::time_point m_start;
+};
+
+}
+
+map<u256, u256> OptimiserPassManager::run()
+{
+	bool changed = true;
+	while (changed)
+	{
+		changed = runPeephole();
+		if (!m_enable)
+			break;
+		// This only modifies PushTags, we have to run again to actually remove code.
+		if (runDeduplicator())
+			changed = true;
+		if (runControlFlow())
+			changed = true;
+		if (runCSE())
+			changed = true;
+	}
+	return m_tagReplacements;
+}
+
+string OptimiserPassManager::passName(Pass _pass)
+{
+	switch (_pass)
+	{
+	case Peephole:
+		return "peephole";
+	case Deduplicator:
+		return "deduplicator";
+	case ControlFlow:
+		return "controlflow";
+	case CSE:
+		return "cse";
+	default:
+		return "";
+	}
+}
+
+bool OptimiserPassManager::runPeephole()
+{
+	PassStatistics& statistics = m_statistics[Peephole];
+	ScopeTimer timer(statistics.milliseconds);
+	statistics.runs++;
+
+	// A single run applies the rules until none of them matches anymore.
+	PeepholeOptimiser peepOpt(m_items);
+	if (!peepOpt.optimise())
+		return false;
+	statistics.changes += peepOpt.replacements();
+	return true;
+}
+
+bool OptimiserPassManager::runDeduplicator()
+{
+	PassStatistics& statistics = m_statistics[Deduplicator];
+	ScopeTimer timer(statistics.milliseconds);
+	statistics.runs++;
+
+	BlockDeduplicator dedup(m_items);
+	if (!dedup.deduplicate())
+		return false;
+	m_tagReplacements.insert(dedup.replacedTags().begin(), dedup.replacedTags().end());
+	for (auto const& replacement: dedup.replacedTags())
+		if (m_externalTags.erase(replacement.first))
+			m_externalTags.insert(replacement.second);
+	statistics.changes += dedup.replacedTags().size();
+	return true;
+}
+
+bool OptimiserPassManager::runControlFlow()
+{
+	PassStatistics& statistics = m_statistics[ControlFlow];
+	ScopeTimer timer(statistics.milliseconds);
+	statistics.runs++;
+
+	ControlFlowGraph cfg(m_items, true, m_externalTags);
+	AssemblyItems optimisedItems;
+	for (BasicBlock const& block: cfg.optimisedBlocks())
+	{
+		auto iter = m_items.cbegin() + block.begin;
+		auto const end = m_items.cbegin() + block.end;
+		if (iter != end && iter->type() == Tag)
+			optimisedItems.push_back(*iter++);
+
+		// Only constants on the stack and in storage and memory are carried over from the
+		// predecessors, the first CSE block of this block is optimised with them. The rest is
+		// left to the CSE pass.
+		KnownState state = block.startState->constantKnowledge();
+		bool knowsSomething =
+			!state.stackElements().empty() ||
+			!state.storageContent().empty() ||
+			!state.memoryContent().empty();
+		if (iter != end && knowsSomething)
+		{
+			CommonSubexpressionEliminator eliminator(state);
+			auto blockEnd = eliminator.feedItems(iter, end);
+			try
+			{
+				AssemblyItems optimisedBlock = eliminator.getOptimizedItems();
+				if (optimisedBlock.size() < size_t(blockEnd - iter))
+				{
+					optimisedItems += optimisedBlock;
+					iter = blockEnd;
+				}
+			}
+			catch (StackTooDeepException const&)
+			{
+				// The original items are kept, see runCSE.
+			}
+			catch (ItemNotAvailableException const&)
+			{
+			}
+		}
+		copy(iter, end, back_inserter(optimisedItems));
+	}
+
+	// Only use the result if it is smaller, the order of the blocks alone does not matter.
+	if (optimisedItems.size() >= m_items.size())
+		return false;
+	statistics.changes += m_items.size() - optimisedItems.size();
+	m_items = move(optimisedItems);
+	return true;
+}
+
+bool OptimiserPassManager::runCSE()
+{
+	PassStatistics& statistics = m_statistics[CSE];
+	ScopeTimer timer(statistics.milliseconds);
+	statistics.runs++;
+
+	struct Block
+	{
+		AssemblyItems::const_iterator begin;
+		AssemblyItems::const_iterator end;
+		size_t hash;
+		/// Index of an earlier block with the same content, if any.
+		size_t original;
+		bool replace = false;
+		AssemblyItems optimisedItems;
+	};
+
+	vector<Block> blocks;
+	vector<size_t> blocksToOptimise;
+	vector<size_t> duplicateBlocks;
+	unordered_multimap<size_t, size_t> blocksByHash;
+	for (auto iter = m_items.cbegin(); iter != m_items.cend();)
+	{
+		Block block;
+		block.begin = iter;
+		// Same block boundaries as CommonSubexpressionEliminator::feedItems, including the
+		// breaking item.
+		block.end = find_if(iter, m_items.cend(), SemanticInformation::breaksCSEAnalysisBlock);
+		if (block.end != m_items.cend())
+			++block.end;
+		block.hash = hashItems(block.begin, block.end);
+		block.original = blocks.size();
+		iter = block.end;
+
+		if (isKnownUnimprovable(block.hash, block.begin, block.end))
+			statistics.skippedBlocks++;
+		else
+		{
+			auto range = blocksByHash.equal_range(block.hash);
+			for (auto it = range.first; it != range.second && block.original == blocks.size(); ++it)
+			{
+				Block const& other = blocks[it->second];
+				if (
+					other.end - other.begin == block.end - block.begin &&
+					equal(block.begin, block.end, other.begin)
+				)
+					block.original = it->second;
+			}
+			if (block.original == blocks.size())
+			{
+				blocksByHash.insert(make_pair(block.hash, blocks.size()));
+				blocksToOptimise.push_back(blocks.size());
+			}
+			else
+				duplicateBlocks.push_back(blocks.size());
+		}
+		blocks.push_back(move(block));
+	}
+
+	// Every block is optimised starting from an empty state with its own expression classes,
+	// so the result does not depend on the order or the thread.
+	auto optimiseBlocks = [&](vector<size_t> const& _indices)
+	{
+		parallelFor(
+			m_threadPool,
+			_indices.size(),
+			[&](size_t _index)
+			{
+				Block& block = blocks[_indices[_index]];
+				KnownState emptyState;
+				CommonSubexpressionEliminator eliminator(emptyState);
+				auto iter = eliminator.feedItems(block.begin, block.end);
+				assertThrow(iter == block.end, OptimizerException, "Unexpected end of CSE block.");
+				try
+				{
+					block.optimisedItems = eliminator.getOptimizedItems();
+					block.replace = (block.optimisedItems.size() < size_t(block.end - block.begin));
+				}
+				catch (StackTooDeepException const&)
+				{
+					// This might happen if the opcode reconstruction is not as efficient
+					// as the hand-crafted code.
+				}
+				catch (ItemNotAvailableException const&)
+				{
+					// This might happen if e.g. associativity and commutativity rules
+					// reorganise the expression tree, but not all leaves are available.
+				}
+			}
+		);
+	};
+
+	optimiseBlocks(blocksToOptimise);
+	// Copies of blocks that could be improved are optimised themselves, so that the
+	// optimised items keep their own source locations.
+	vector<size_t> improvableDuplicates;
+	for (size_t index: duplicateBlocks)
+		if (blocks[blocks[index].original].replace)
+			improvableDuplicates.push_back(index);
+		else
+			statistics.skippedBlocks++;
+	optimiseBlocks(improvableDuplicates);
+
+	for (size_t index: blocksToOptimise)
+		if (!blocks[index].replace)
+			m_unimprovableBlocks.insert(make_pair(blocks[index].hash, AssemblyItems(blocks[index].begin, blocks[index].end)));
+
+	size_t changes = count_if(blocks.begin(), blocks.end(), [](Block const& _block) { return _block.replace; });
+	if (changes == 0)
+		return false;
+	statistics.changes += changes;
+
+	AssemblyItems optimisedItems;
+	for (Block const& block: blocks)
+		if (block.replace)
+			optimisedItems += block.optimisedItems;
+		else
+			copy(block.begin, block.end, back_inserter(optimisedItems));
+	m_items = move(optimisedItems);
+	return true;
+}
+
+void OptimiserPassManager::parallelFor(ThreadPool* _threadPool, size_t _count, function<void(size_t)> const& _body)
+{
+	if (_threadPool)
+		_threadPool->parallelFor(_count, _body);
+	else
+		for (size_t i = 0; i < _count; ++i)
+			_body(i);
+}
+
+bool OptimiserPassManager::isKnownUnimprovable(
+	size_t _hash,
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end
+) const
+{
+	auto range = m_unimprovableBlocks.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (it->second.size() == size_t(_end - _begin) && equal(_begin, _end, it->second.begin()))
+			return true;
+	return false;
+}
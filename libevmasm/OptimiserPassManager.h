@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file OptimiserPassManager.h
+ * @date 2017
+ * Runs the optimisation passes on the items of an assembly until they do not change anymore.
+ */
+
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <libdevcore/ThreadPool.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Runs the peephole optimiser, the block deduplicator, the control flow graph optimiser and the
+ * common subexpression eliminator in turn until none of them changes the items anymore.
+ *
+ * The control flow graph optimiser removes unreachable blocks, joins blocks that are only
+ * jumped to from a single place and optimises the start of blocks whose stack, storage or
+ * memory is known to contain constants at every way to enter them, e.g. to remove an SLOAD of a
+ * slot that was stored to before the jump.
+ *
+ * The common subexpression eliminator only depends on the items of the block it optimises.
+ * Blocks it could not improve are remembered by their content and skipped in later rounds,
+ * so after the first round it only runs on blocks that were changed by one of the passes.
+ * The remaining blocks are independent of each other and are optimised concurrently.
+ */
+class OptimiserPassManager: private boost::noncopyable
+{
+public:
+	enum Pass { Peephole, Deduplicator, ControlFlow, CSE, PassCount };
+
+	struct PassStatistics
+	{
+		/// Number of times the pass was run on the items.
+		size_t runs = 0;
+		/// Number of changes the pass made, for the peephole optimiser this is the number of
+		/// replacements, for the common subexpression eliminator the number of blocks replaced,
+		/// for the control flow graph optimiser the number of items removed.
+		size_t changes = 0;
+		/// Number of blocks that were not optimised again because their content did not change.
+		size_t skippedBlocks = 0;
+		double milliseconds = 0;
+	};
+
+	/// @param _enable if false, only the peephole optimiser is run.
+	/// @param _threadPool threads used to optimise blocks concurrently, if given.
+	/// @param _externalTags tags that are pushed by other assemblies and thus might be jumped to.
+	OptimiserPassManager(
+		AssemblyItems& _items,
+		bool _enable,
+		ThreadPool* _threadPool = nullptr,
+		std::set<u256> const& _externalTags = std::set<u256>()
+	):
+		m_items(_items), m_enable(_enable), m_threadPool(_threadPool), m_externalTags(_externalTags) {}
+
+	/// Runs the passes until a fixed point is reached.
+	/// @returns the tags that were replaced by the block deduplicator.
+	std::map<u256, u256> run();
+
+	PassStatistics const& statistics(Pass _pass) const { return m_statistics[_pass]; }
+	static std::string passName(Pass _pass);
+
+	/// Calls @a _body for all numbers from zero to @a _count - 1 on the threads of @a _threadPool
+	/// or, if it is null, sequentially.
+	static void parallelFor(ThreadPool* _threadPool, size_t _count, std::function<void(size_t)> const& _body);
+
+private:
+	bool runPeephole();
+	bool runDeduplicator();
+	bool runControlFlow();
+	bool runCSE();
+
+	/// @returns true if the CSE already failed to improve a block with the same content as
+	/// the items between @a _begin and @a _end.
+	bool isKnownUnimprovable(size_t _hash, AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end) const;
+
+	AssemblyItems& m_items;
+	bool m_enable;
+	ThreadPool* m_threadPool;
+	/// Tags pushed by other assemblies, updated with the tags replaced by the block deduplicator.
+	std::set<u256> m_externalTags;
+	std::map<u256, u256> m_tagReplacements;
+	/// Blocks the CSE could not improve, keyed by the hash of their items.
+	std::unordered_multimap<size_t, AssemblyItems> m_unimprovableBlocks;
+	PassStatistics m_statistics[PassCount];
+};
+
+}
+}
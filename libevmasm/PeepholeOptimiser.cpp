@@ -24,233 +24,393 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+
 using namespace std;
 using namespace dev::eth;
 using namespace dev;
 
 // TODO: Extend this to use the tools from ExpressionClasses.cpp
 
-struct OptimiserState
+namespace
 {
-	AssemblyItems const& items;
-	size_t i;
-	std::back_insert_iterator<AssemblyItems> out;
-};
 
-template <class Method, size_t Arguments>
-struct ApplyRule
+/// Key of an item in the automaton: its type and, for operations, its instruction.
+using ItemKey = pair<AssemblyItemType, Instruction>;
+/// Items that can appear at one position of a pattern.
+using ItemKeys = set<ItemKey>;
+
+ItemKey keyOf(AssemblyItem const& _item)
 {
-};
-template <class Method>
-struct ApplyRule<Method, 3>
+	return make_pair(_item.type(), _item.type() == Operation ? _item.instruction() : Instruction::STOP);
+}
+
+ItemKeys operations(vector<Instruction> const& _instructions)
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		return Method::applySimple(_in[0], _in[1], _in[2], _out);
-	}
-};
-template <class Method>
-struct ApplyRule<Method, 2>
+	ItemKeys keys;
+	for (Instruction instruction: _instructions)
+		keys.insert(make_pair(Operation, instruction));
+	return keys;
+}
+
+ItemKeys operationsWhere(function<bool(AssemblyItem const&)> const& _predicate)
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		return Method::applySimple(_in[0], _in[1], _out);
-	}
-};
-template <class Method>
-struct ApplyRule<Method, 1>
+	ItemKeys keys;
+	for (auto const& instruction: c_instructions)
+		if (_predicate(AssemblyItem(instruction.second)))
+			keys.insert(make_pair(Operation, instruction.second));
+	return keys;
+}
+
+ItemKeys itemsOfTypes(vector<AssemblyItemType> const& _types)
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		return Method::applySimple(_in[0], _out);
-	}
+	ItemKeys keys;
+	for (AssemblyItemType type: _types)
+		keys.insert(make_pair(type, Instruction::STOP));
+	return keys;
+}
+
+/// Items that push a value without side effects.
+ItemKeys pushes()
+{
+	return itemsOfTypes({
+		Push, PushString, PushTag, PushSub, PushSubSize, PushProgramSize, PushData, PushLibraryAddress
+	});
+}
+
+ItemKeys operator+(ItemKeys _a, ItemKeys const& _b)
+{
+	_a.insert(_b.begin(), _b.end());
+	return _a;
+}
+
+/**
+ * A rule replaces a window of items that matches its pattern (and condition).
+ * Every rule has to reduce the number of items other than POP or keep it and reduce the size of
+ * the code, which ensures that rescanning after replacements terminates.
+ */
+struct Rule
+{
+	Rule(
+		vector<ItemKeys> const& _pattern,
+		function<bool(AssemblyItems const&)> const& _condition,
+		function<AssemblyItems(AssemblyItems const&)> const& _replacement,
+		bool _extendsToTag = false
+	):
+		pattern(_pattern), condition(_condition), replacement(_replacement), extendsToTag(_extendsToTag) {}
+
+	/// Items the positions of the window can be.
+	vector<ItemKeys> pattern;
+	/// Further condition on the items of the window, always true if not set.
+	function<bool(AssemblyItems const&)> condition;
+	/// @returns the items that replace the window.
+	function<AssemblyItems(AssemblyItems const&)> replacement;
+	/// If set, the window also contains all items after the pattern up to the next tag and the
+	/// rule only matches if there is at least one such item.
+	bool extendsToTag;
 };
 
-template <class Method, size_t WindowSize>
-struct SimplePeepholeOptimizerMethod
+/// @returns the table of rules. Rules that come first take precedence.
+vector<Rule> peepholeRules()
 {
-	static bool apply(OptimiserState& _state)
-	{
-		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + _state.i, _state.out)
-		)
+	vector<Rule> rules;
+	// Push followed by POP.
+	rules.push_back({
+		{pushes() + operationsWhere(SemanticInformation::isDupInstruction), operations({Instruction::POP})},
+		nullptr,
+		[](AssemblyItems const&) { return AssemblyItems{}; }
+	});
+	// Operation without side effects whose result is discarded.
+	rules.push_back({
 		{
-			_state.i += WindowSize;
-			return true;
+			operationsWhere([](AssemblyItem const& _op) -> bool {
+				InstructionInfo info = instructionInfo(_op.instruction());
+				return info.ret == 1 && !info.sideEffects;
+			}),
+			operations({Instruction::POP})
+		},
+		nullptr,
+		[](AssemblyItems const& _window) {
+			return AssemblyItems(_window[0].arguments(), AssemblyItem(Instruction::POP, _window[0].location()));
 		}
-		else
-			return false;
-	}
-};
+	});
+	// Pushing the same value twice.
+	rules.push_back({
+		{itemsOfTypes({Push}), itemsOfTypes({Push})},
+		[](AssemblyItems const& _window) { return _window[0].data() == _window[1].data(); },
+		[](AssemblyItems const& _window) {
+			return AssemblyItems{_window[0], AssemblyItem(Instruction::DUP1, _window[1].location())};
+		}
+	});
+	// Swaps that cancel out.
+	rules.push_back({
+		{operationsWhere(SemanticInformation::isSwapInstruction), operationsWhere(SemanticInformation::isSwapInstruction)},
+		[](AssemblyItems const& _window) { return _window[0] == _window[1]; },
+		[](AssemblyItems const&) { return AssemblyItems{}; }
+	});
+	// Jump to the next item.
+	rules.push_back({
+		{itemsOfTypes({PushTag}), operations({Instruction::JUMP, Instruction::JUMPI}), itemsOfTypes({Tag})},
+		[](AssemblyItems const& _window) { return _window[0].data() == _window[2].data(); },
+		[](AssemblyItems const& _window) -> AssemblyItems {
+			if (_window[1] == Instruction::JUMPI)
+				return AssemblyItems{AssemblyItem(Instruction::POP, _window[1].location()), _window[2]};
+			return AssemblyItems{_window[2]};
+		}
+	});
+	// Unreachable code after a JUMP (or similar) until the next JUMPDEST.
+	rules.push_back({
+		{operations({
+			Instruction::JUMP,
+			Instruction::RETURN,
+			Instruction::STOP,
+			Instruction::INVALID,
+			Instruction::SELFDESTRUCT,
+			Instruction::REVERT
+		})},
+		nullptr,
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[0]}; },
+		true
+	});
+	// Masking a tag with a mask that keeps at least its lowest four bytes.
+	rules.push_back({
+		{itemsOfTypes({PushTag}), itemsOfTypes({Push}), operations({Instruction::AND})},
+		[](AssemblyItems const& _window) {
+			return (_window[1].data() & u256(0xFFFFFFFF)) == u256(0xFFFFFFFF);
+		},
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[0]}; }
+	});
+	// Swapping the arguments of a commutative operation.
+	rules.push_back({
+		{operations({Instruction::SWAP1}), operationsWhere(SemanticInformation::isCommutativeOperation)},
+		nullptr,
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[1]}; }
+	});
+	// Swapping a value with its copy.
+	rules.push_back({
+		{operations({Instruction::DUP1}), operations({Instruction::SWAP1})},
+		nullptr,
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[0]}; }
+	});
+	// Swapping two pushed values.
+	rules.push_back({
+		{pushes(), pushes(), operations({Instruction::SWAP1})},
+		nullptr,
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[1], _window[0]}; }
+	});
+	// Negating the condition of a jump twice.
+	rules.push_back({
+		{
+			operations({Instruction::ISZERO}),
+			operations({Instruction::ISZERO}),
+			itemsOfTypes({PushTag}),
+			operations({Instruction::JUMPI})
+		},
+		nullptr,
+		[](AssemblyItems const& _window) { return AssemblyItems{_window[2], _window[3]}; }
+	});
+	// Conditional jump with a constant condition.
+	rules.push_back({
+		{itemsOfTypes({Push}), itemsOfTypes({PushTag}), operations({Instruction::JUMPI})},
+		nullptr,
+		[](AssemblyItems const& _window) -> AssemblyItems {
+			if (_window[0].data() == 0)
+				return AssemblyItems{};
+			return AssemblyItems{_window[1], AssemblyItem(Instruction::JUMP, _window[2].location())};
+		}
+	});
+	// Conditional jump over an unconditional jump.
+	rules.push_back({
+		{
+			itemsOfTypes({PushTag}),
+			operations({Instruction::JUMPI}),
+			itemsOfTypes({PushTag}),
+			operations({Instruction::JUMP}),
+			itemsOfTypes({Tag})
+		},
+		[](AssemblyItems const& _window) { return _window[0].data() == _window[4].data(); },
+		[](AssemblyItems const& _window) {
+			return AssemblyItems{
+				AssemblyItem(Instruction::ISZERO, _window[1].location()),
+				_window[2],
+				_window[1],
+				_window[4]
+			};
+		}
+	});
+	return rules;
+}
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
+/// @returns the stack height needed by @a _items and the change of the stack height, both up to
+/// the first item that alters the control flow.
+pair<int, int> stackEffect(AssemblyItems const& _items)
 {
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
+	int needed = 0;
+	int height = 0;
+	for (AssemblyItem const& item: _items)
 	{
-		*_out = _item;
-		return true;
+		needed = max(needed, item.arguments() - height);
+		height += item.deposit();
+		if (SemanticInformation::altersControlFlow(item))
+			break;
 	}
-};
+	return make_pair(needed, height);
+}
 
-struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
+bool reducesCost(AssemblyItems const& _window, AssemblyItems const& _replacement)
 {
-	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
+	auto nonPops = [](AssemblyItems const& _items)
 	{
-		auto t = _push.type();
-		return _pop == Instruction::POP && (
-			SemanticInformation::isDupInstruction(_push) ||
-			t == Push || t == PushString || t == PushTag || t == PushSub ||
-			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress
+		return count_if(_items.begin(), _items.end(), [](AssemblyItem const& _item) { return _item != Instruction::POP; });
+	};
+	auto windowItems = nonPops(_window);
+	auto replacementItems = nonPops(_replacement);
+	return
+		replacementItems < windowItems || (
+			replacementItems == windowItems &&
+			eth::bytesRequired(_replacement, 3) < eth::bytesRequired(_window, 3)
 		);
-	}
-};
+}
 
-struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
+/**
+ * The rules compiled into a trie over the keys of their pattern items, so that for a position
+ * only the rules whose pattern fits the items are considered.
+ */
+class RuleAutomaton
 {
-	static bool applySimple(
-		AssemblyItem const& _op,
-		AssemblyItem const& _pop,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
+public:
+	static RuleAutomaton const& instance()
 	{
-		if (_pop == Instruction::POP && _op.type() == Operation)
-		{
-			Instruction instr = _op.instruction();
-			if (instructionInfo(instr).ret == 1 && !instructionInfo(instr).sideEffects)
-			{
-				for (int j = 0; j < instructionInfo(instr).args; j++)
-					*_out = {Instruction::POP, _op.location()};
-				return true;
-			}
-		}
-		return false;
+		static RuleAutomaton const automaton;
+		return automaton;
 	}
-};
 
-struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
-{
-	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
+	/// Replaces the window of the first rule that matches the items at the end of @a _reversedItems,
+	/// which contains the items in reverse order. The replacement is added in reverse order as well.
+	/// @returns true if a rule matched.
+	bool applyFirstMatch(AssemblyItems& _reversedItems) const;
+
+	size_t maxPatternLength() const { return m_maxPatternLength; }
+
+private:
+	struct Node
 	{
-		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
-	}
+		map<ItemKey, unique_ptr<Node>> children;
+		/// Rules whose pattern ends at this node.
+		vector<size_t> rules;
+	};
+
+	RuleAutomaton();
+	void insert(size_t _rule, Node& _node, size_t _position);
+
+	vector<Rule> m_rules;
+	Node m_root;
+	size_t m_maxPatternLength = 0;
 };
 
-struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
+RuleAutomaton::RuleAutomaton(): m_rules(peepholeRules())
 {
-	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
+	for (size_t i = 0; i < m_rules.size(); ++i)
 	{
-		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
-		{
-			*_out = _push1;
-			*_out = {Instruction::DUP1, _push2.location()};
-			return true;
-		}
-		else
-			return false;
+		insert(i, m_root, 0);
+		m_maxPatternLength = max(m_maxPatternLength, m_rules[i].pattern.size());
 	}
-};
+}
 
-struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
+void RuleAutomaton::insert(size_t _rule, Node& _node, size_t _position)
 {
-	static size_t applySimple(
-		AssemblyItem const& _pushTag,
-		AssemblyItem const& _jump,
-		AssemblyItem const& _tag,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
+	vector<ItemKeys> const& pattern = m_rules[_rule].pattern;
+	if (_position == pattern.size())
 	{
-		if (
-			_pushTag.type() == PushTag &&
-			(_jump == Instruction::JUMP || _jump == Instruction::JUMPI) &&
-			_tag.type() == Tag &&
-			_pushTag.data() == _tag.data()
-		)
-		{
-			if (_jump == Instruction::JUMPI)
-				*_out = AssemblyItem(Instruction::POP, _jump.location());
-			*_out = _tag;
-			return true;
-		}
-		else
-			return false;
+		_node.rules.push_back(_rule);
+		return;
 	}
-};
+	for (ItemKey const& key: pattern[_position])
+	{
+		unique_ptr<Node>& child = _node.children[key];
+		if (!child)
+			child.reset(new Node());
+		insert(_rule, *child, _position + 1);
+	}
+}
 
-struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
+bool RuleAutomaton::applyFirstMatch(AssemblyItems& _reversedItems) const
 {
-	static bool applySimple(
-		AssemblyItem const& _pushTag,
-		AssemblyItem const& _pushConstant,
-		AssemblyItem const& _and,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
+	size_t const available = _reversedItems.size();
+	auto item = [&](size_t _index) -> AssemblyItem const& { return _reversedItems[available - 1 - _index]; };
+
+	vector<size_t> candidates;
+	Node const* node = &m_root;
+	for (size_t i = 0; i < available; ++i)
 	{
-		if (
-			_pushTag.type() == PushTag &&
-			_and == Instruction::AND &&
-			_pushConstant.type() == Push &&
-			(_pushConstant.data() & u256(0xFFFFFFFF)) == u256(0xFFFFFFFF)
-		)
-		{
-			*_out = _pushTag;
-			return true;
-		}
-		else
-			return false;
+		auto child = node->children.find(keyOf(item(i)));
+		if (child == node->children.end())
+			break;
+		node = child->second.get();
+		candidates.insert(candidates.end(), node->rules.begin(), node->rules.end());
 	}
-};
+	sort(candidates.begin(), candidates.end());
 
-/// Removes everything after a JUMP (or similar) until the next JUMPDEST.
-struct UnreachableCode
-{
-	static bool apply(OptimiserState& _state)
+	for (size_t index: candidates)
 	{
-		auto it = _state.items.begin() + _state.i;
-		auto end = _state.items.end();
-		if (it == end)
-			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
-			return false;
-
-		size_t i = 1;
-		while (it + i != end && it[i].type() != Tag)
-			i++;
-		if (i > 1)
+		Rule const& rule = m_rules[index];
+		size_t windowSize = rule.pattern.size();
+		if (rule.extendsToTag)
 		{
-			*_state.out = it[0];
-			_state.i += i;
-			return true;
+			while (windowSize < available && item(windowSize).type() != Tag)
+				windowSize++;
+			if (windowSize == rule.pattern.size())
+				continue;
 		}
-		else
-			return false;
+		AssemblyItems window(_reversedItems.rbegin(), _reversedItems.rbegin() + windowSize);
+		if (rule.condition && !rule.condition(window))
+			continue;
+		AssemblyItems replacement = rule.replacement(window);
+		assertThrow(
+			stackEffect(replacement).first <= stackEffect(window).first &&
+			stackEffect(replacement).second == stackEffect(window).second,
+			OptimizerException,
+			"Peephole rule changes the stack layout."
+		);
+		assertThrow(reducesCost(window, replacement), OptimizerException, "Peephole rule does not reduce the cost.");
+		_reversedItems.erase(_reversedItems.end() - windowSize, _reversedItems.end());
+		_reversedItems.insert(_reversedItems.end(), replacement.rbegin(), replacement.rend());
+		return true;
 	}
-};
-
-void applyMethods(OptimiserState&)
-{
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
-{
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(state, PushPop(), OpPop(), DoublePush(), DoubleSwap(), JumpToNext(), UnreachableCode(), TagConjunctions(), Identity());
+	RuleAutomaton const& automaton = RuleAutomaton::instance();
+	m_replacements = 0;
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
+	// The items that still have to be scanned, in reverse order.
+	AssemblyItems remaining(m_items.rbegin(), m_items.rend());
+	while (!remaining.empty())
+		if (automaton.applyFirstMatch(remaining))
+		{
+			m_replacements++;
+			// The replacement might complete a pattern that starts before it.
+			for (size_t i = 1; i < automaton.maxPatternLength() && !m_optimisedItems.empty(); ++i)
+			{
+				remaining.push_back(move(m_optimisedItems.back()));
+				m_optimisedItems.pop_back();
+			}
+		}
+		else
+		{
+			m_optimisedItems.push_back(move(remaining.back()));
+			remaining.pop_back();
+		}
+
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() &&
 		eth::bytesRequired(m_optimisedItems, 3) < eth::bytesRequired(m_items, 3)
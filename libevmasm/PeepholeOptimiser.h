@@ -31,23 +31,29 @@ namespace eth
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 
-class PeepholeOptimisationMethod
-{
-public:
-	virtual size_t windowSize() const;
-	virtual bool apply(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out);
-};
-
+/**
+ * Replaces short sequences of items by cheaper equivalent ones, according to a table of rules.
+ * The rules are compiled into an automaton over the items, so the item list is scanned once and
+ * only the rules whose pattern fits the items at a position are checked. After a replacement,
+ * the scan backs up by the length of the longest pattern, so replacements that enable other
+ * replacements are applied in the same scan.
+ */
 class PeepholeOptimiser
 {
 public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 
+	/// Applies the rules until none of them matches anymore.
+	/// @returns true if the items were changed, i.e. if they got smaller.
 	bool optimise();
 
+	/// @returns the number of replacements done by the last call to @a optimise.
+	size_t replacements() const { return m_replacements; }
+
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	size_t m_replacements = 0;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <utility>
 #include <tuple>
 #include <functional>
+#include <algorithm>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/noncopyable.hpp>
 #include <libevmasm/Assembly.h>
@@ -36,20 +37,35 @@ using namespace dev;
 using namespace dev::eth;
 
 
+Rules const& Rules::instance()
+{
+	static Rules const rules;
+	return rules;
+}
+
 pair<Pattern, function<Pattern()> > const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
-)
+) const
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[byte(_expr.item->instruction())])
+	// Kept across calls to avoid allocations.
+	static thread_local vector<Expression const*> pending;
+	static thread_local vector<size_t> candidates;
+	candidates.clear();
+	pending.assign(1, &_expr);
+	collectCandidates(m_root, _classes, pending, candidates);
+	// The net only checks the structure, match groups appearing more than once still
+	// have to be verified. Rules added earlier take precedence.
+	sort(candidates.begin(), candidates.end());
+	map<unsigned, Expression const*>& matchGroups = Pattern::threadMatchGroups();
+	for (size_t index: candidates)
 	{
-		if (rule.first.matches(_expr, _classes))
-			return &rule;
-		resetMatchGroups();
+		matchGroups.clear();
+		if (m_rules[index].first.matches(_expr, _classes))
+			return &m_rules[index];
 	}
+	matchGroups.clear();
 	return nullptr;
 }
 
@@ -61,7 +77,82 @@ void Rules::addRules(std::vector<std::pair<Pattern, std::function<Pattern ()> >
 
 void Rules::addRule(std::pair<Pattern, std::function<Pattern()> > const& _rule)
 {
-	m_rules[byte(_rule.first.instruction())].push_back(_rule);
+	assertThrow(_rule.first.type() == Operation, OptimizerException, "");
+	insertPattern(m_root, _rule.first).rules.push_back(m_rules.size());
+	m_rules.push_back(_rule);
+}
+
+Rules::Node& Rules::insertPattern(Node& _node, Pattern const& _pattern)
+{
+	unique_ptr<Node>* child = nullptr;
+	if (_pattern.type() == UndefinedItem)
+		child = &_node.anything;
+	else if (_pattern.type() == Operation)
+		child = &_node.operations[make_pair(_pattern.instruction(), _pattern.arguments().size())];
+	else if (_pattern.requiresDataMatch())
+	{
+		assertThrow(_pattern.type() == Push, OptimizerException, "");
+		child = &_node.constants[_pattern.data()];
+	}
+	else
+		child = &_node.anyOfType[_pattern.type()];
+	if (!*child)
+		child->reset(new Node());
+
+	Node* node = child->get();
+	for (Pattern const& argument: _pattern.arguments())
+		node = &insertPattern(*node, argument);
+	return *node;
+}
+
+void Rules::collectCandidates(
+	Node const& _node,
+	ExpressionClasses const& _classes,
+	vector<Expression const*>& _pending,
+	vector<size_t>& _candidates
+)
+{
+	if (_pending.empty())
+	{
+		_candidates.insert(_candidates.end(), _node.rules.begin(), _node.rules.end());
+		return;
+	}
+
+	Expression const* expr = _pending.back();
+	_pending.pop_back();
+	if (_node.anything)
+		collectCandidates(*_node.anything, _classes, _pending, _candidates);
+	if (AssemblyItem const* item = expr->item)
+	{
+		auto ofType = _node.anyOfType.find(item->type());
+		if (ofType != _node.anyOfType.end())
+			collectCandidates(*ofType->second, _classes, _pending, _candidates);
+		if (item->type() == Push)
+		{
+			auto constant = _node.constants.find(item->data());
+			if (constant != _node.constants.end())
+				collectCandidates(*constant->second, _classes, _pending, _candidates);
+		}
+		else if (item->type() == Operation)
+		{
+			auto operation = _node.operations.find(make_pair(item->instruction(), size_t(0)));
+			if (operation != _node.operations.end())
+				collectCandidates(*operation->second, _classes, _pending, _candidates);
+			size_t arguments = expr->arguments.size();
+			if (arguments > 0)
+			{
+				operation = _node.operations.find(make_pair(item->instruction(), arguments));
+				if (operation != _node.operations.end())
+				{
+					for (ExpressionClasses::Id argument: expr->arguments | boost::adaptors::reversed)
+						_pending.push_back(&_classes.representative(argument));
+					collectCandidates(*operation->second, _classes, _pending, _candidates);
+					_pending.resize(_pending.size() - arguments);
+				}
+			}
+		}
+	}
+	_pending.push_back(expr);
 }
 
 template <class S> S divWorkaround(S const& _a, S const& _b)
@@ -85,12 +176,12 @@ Rules::Rules()
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	X.setMatchGroup(4, m_matchGroups);
-	Y.setMatchGroup(5, m_matchGroups);
-	Z.setMatchGroup(6, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	X.setMatchGroup(4);
+	Y.setMatchGroup(5);
+	Z.setMatchGroup(6);
 
 	addRules(vector<pair<Pattern, function<Pattern()>>>{
 		// arithmetics on constants
@@ -258,15 +349,28 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 	m_matchGroups = &_matchGroups;
 }
 
+void Pattern::setMatchGroup(unsigned _group)
+{
+	m_matchGroup = _group;
+	m_matchGroups = nullptr;
+}
+
+map<unsigned, Pattern::Expression const*>& Pattern::threadMatchGroups()
+{
+	static thread_local map<unsigned, Expression const*> matchGroups;
+	return matchGroups;
+}
+
 bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes) const
 {
 	if (!matchesBaseItem(_expr.item))
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		map<unsigned, Expression const*>& groups = matchGroups();
+		if (!groups.count(m_matchGroup))
+			groups[m_matchGroup] = &_expr;
+		else if (groups[m_matchGroup]->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -276,7 +380,7 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
-AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
+AssemblyItem Pattern::toAssemblyItem(ItemLocation const& _location) const
 {
 	if (m_type == Operation)
 		return AssemblyItem(m_instruction, _location);
@@ -337,9 +441,8 @@ bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
 Pattern::Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	assertThrow(matchGroups()[m_matchGroup], OptimizerException, "");
+	return *matchGroups()[m_matchGroup];
 }
 
 u256 const& Pattern::data() const
@@ -348,7 +451,7 @@ u256 const& Pattern::data() const
 	return *m_data;
 }
 
-ExpressionTemplate::ExpressionTemplate(Pattern const& _pattern, SourceLocation const& _location)
+ExpressionTemplate::ExpressionTemplate(Pattern const& _pattern, ItemLocation const& _location)
 {
 	if (_pattern.matchGroup())
 	{
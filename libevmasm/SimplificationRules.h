@@ -26,6 +26,8 @@
 #include <libevmasm/ExpressionClasses.h>
 
 #include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -37,6 +39,11 @@ class Pattern;
 
 /**
  * Container for all simplification rules.
+ * The rules are indexed by a discrimination net over the preorder sequence of the items in
+ * their patterns, so finding the candidates for an expression costs roughly the depth of the
+ * patterns instead of the number of rules for its top-level instruction.
+ * The rules are not modified by matching, so one instance can be shared by all threads. The
+ * expressions matched by their patterns are stored per thread.
  */
 class Rules: public boost::noncopyable
 {
@@ -45,21 +52,50 @@ public:
 
 	Rules();
 
+	/// @returns the rules, which are created on first use.
+	static Rules const& instance();
+
 	/// @returns a pointer to the first matching pattern and sets the match
-	/// groups accordingly.
+	/// groups of the current thread accordingly.
 	std::pair<Pattern, std::function<Pattern()>> const* findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
-	);
+	) const;
 
 private:
 	void addRules(std::vector<std::pair<Pattern, std::function<Pattern()>>> const& _rules);
 	void addRule(std::pair<Pattern, std::function<Pattern()>> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	/// Node of the discrimination net. Every edge stands for one item of a pattern in preorder.
+	struct Node
+	{
+		/// Child for patterns that match anything.
+		std::unique_ptr<Node> anything;
+		/// Children for patterns that match any item of a given type.
+		std::map<AssemblyItemType, std::unique_ptr<Node>> anyOfType;
+		/// Children for patterns that match a specific constant.
+		std::map<u256, std::unique_ptr<Node>> constants;
+		/// Children for patterns that match an instruction, keyed by the instruction and the
+		/// number of argument patterns (zero if the arguments are not inspected).
+		std::map<std::pair<Instruction, size_t>, std::unique_ptr<Node>> operations;
+		/// Indices into m_rules of the rules whose pattern ends at this node.
+		std::vector<size_t> rules;
+	};
+
+	/// Inserts the items of @a _pattern below @a _node.
+	/// @returns the node reached after the last item of the pattern.
+	static Node& insertPattern(Node& _node, Pattern const& _pattern);
+	/// Walks the net from @a _node along the expressions in @a _pending (in reverse preorder) and
+	/// appends the indices of all rules whose patterns structurally match to @a _candidates.
+	static void collectCandidates(
+		Node const& _node,
+		ExpressionClasses const& _classes,
+		std::vector<Expression const*>& _pending,
+		std::vector<size_t>& _candidates
+	);
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<std::pair<Pattern, std::function<Pattern()>>> m_rules[256];
+	std::vector<std::pair<Pattern, std::function<Pattern()>>> m_rules;
+	Node m_root;
 };
 
 /**
@@ -84,12 +120,20 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
+	/// The matched expressions are stored in @a _matchGroups.
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	/// Same as above, but the matched expressions are stored in threadMatchGroups().
+	void setMatchGroup(unsigned _group);
+	/// @returns the match groups of the current thread.
+	static std::map<unsigned, Expression const*>& threadMatchGroups();
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
-	AssemblyItem toAssemblyItem(SourceLocation const& _location) const;
-	std::vector<Pattern> arguments() const { return m_arguments; }
+	AssemblyItem toAssemblyItem(ItemLocation const& _location) const;
+	std::vector<Pattern> const& arguments() const { return m_arguments; }
+	/// @returns true if this pattern only matches items with the data returned by @a data.
+	bool requiresDataMatch() const { return m_requireDataMatch; }
+	u256 const& data() const;
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
@@ -108,7 +152,10 @@ public:
 private:
 	bool matchesBaseItem(AssemblyItem const* _item) const;
 	Expression const& matchGroupValue() const;
-	u256 const& data() const;
+	std::map<unsigned, Expression const*>& matchGroups() const
+	{
+		return m_matchGroups ? *m_matchGroups : threadMatchGroups();
+	}
 
 	AssemblyItemType m_type;
 	bool m_requireDataMatch = false;
@@ -126,7 +173,7 @@ struct ExpressionTemplate
 {
 	using Expression = ExpressionClasses::Expression;
 	using Id = ExpressionClasses::Id;
-	explicit ExpressionTemplate(Pattern const& _pattern, SourceLocation const& _location);
+	explicit ExpressionTemplate(Pattern const& _pattern, ItemLocation const& _location);
 	std::string toString() const;
 	bool hasId = false;
 	/// Id of the matched expression, if available.
@@ -22,6 +22,7 @@
 
 #include <libsolidity/analysis/ConstantEvaluator.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 using namespace std;
 using namespace dev;
@@ -47,7 +48,7 @@ void ConstantEvaluator::endVisit(BinaryOperation const& _operation)
 		BOOST_THROW_EXCEPTION(_operation.rightExpression().createTypeError("Invalid constant expression."));
 	TypePointer commonType = leftType->binaryOperatorResult(_operation.getOperator(), rightType);
 	if (Token::isCompareOp(_operation.getOperator()))
-		commonType = make_shared<BoolType>();
+		commonType = TypeProvider::boolean();
 	_operation.annotation().type = commonType;
 }
 
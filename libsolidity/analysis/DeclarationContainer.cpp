@@ -28,6 +28,22 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+size_t const NameTable::NotFound;
+
+size_t NameTable::intern(ASTString const& _name)
+{
+	auto inserted = m_ids.insert(make_pair(_name, m_names.size()));
+	if (inserted.second)
+		m_names.push_back(&inserted.first->first);
+	return inserted.first->second;
+}
+
+size_t NameTable::find(ASTString const& _name) const
+{
+	auto id = m_ids.find(_name);
+	return id == m_ids.end() ? NotFound : id->second;
+}
+
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
@@ -37,10 +53,11 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	size_t id = m_names->find(*_name);
+	if (m_declarations.count(id))
+		declarations += m_declarations.at(id);
+	if (m_invisibleDeclarations.count(id))
+		declarations += m_invisibleDeclarations.at(id);
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -90,16 +107,17 @@ bool DeclarationContainer::registerDeclaration(
 	if (_name->empty())
 		return true;
 
+	size_t id = m_names->intern(*_name);
 	if (_update)
 	{
 		solAssert(!dynamic_cast<FunctionDefinition const*>(&_declaration), "Attempt to update function definition.");
-		m_declarations.erase(*_name);
-		m_invisibleDeclarations.erase(*_name);
+		m_declarations.erase(id);
+		m_invisibleDeclarations.erase(id);
 	}
 	else if (conflictingDeclaration(_declaration, _name))
 		return false;
 
-	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
+	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[id] : m_declarations[id];
 	if (!contains(decls, &_declaration))
 		decls.push_back(&_declaration);
 	return true;
@@ -108,10 +126,25 @@ bool DeclarationContainer::registerDeclaration(
 std::vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
-	auto result = m_declarations.find(_name);
-	if (result != m_declarations.end())
-		return result->second;
-	if (_recursive && m_enclosingContainer)
-		return m_enclosingContainer->resolveName(_name, true);
+	// A name that was never declared in any scope of the tree is not found anywhere.
+	size_t id = m_names->find(_name);
+	if (id == NameTable::NotFound)
+		return vector<Declaration const*>({});
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+	{
+		auto result = container->m_declarations.find(id);
+		if (result != container->m_declarations.end())
+			return result->second;
+		if (!_recursive)
+			break;
+	}
 	return vector<Declaration const*>({});
 }
+
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	map<ASTString, vector<Declaration const*>> declarations;
+	for (auto const& idAndDeclarations: m_declarations)
+		declarations[m_names->name(idAndDeclarations.first)] = idAndDeclarations.second;
+	return declarations;
+}
@@ -23,7 +23,10 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 #include <libsolidity/ast/ASTForward.h>
@@ -33,9 +36,30 @@ namespace dev
 namespace solidity
 {
 
+/**
+ * Numbers the names declared in a tree of declaration containers, so that a name is hashed only
+ * once when it is looked up in a scope and all enclosing scopes, which then compare numbers.
+ */
+class NameTable: private boost::noncopyable
+{
+public:
+	static size_t const NotFound = size_t(-1);
+
+	/// @returns the number of @a _name, assigning the next one if it is new.
+	size_t intern(ASTString const& _name);
+	/// @returns the number of @a _name or NotFound if it was never interned.
+	size_t find(ASTString const& _name) const;
+	ASTString const& name(size_t _id) const { return *m_names[_id]; }
+
+private:
+	std::unordered_map<ASTString, size_t> m_ids;
+	/// Points to the keys of m_ids, which do not move.
+	std::vector<ASTString const*> m_names;
+};
+
 /**
  * Container that stores mappings between names and declarations. It also contains a link to the
- * enclosing scope.
+ * enclosing scope. All containers of a tree share the name table of the outermost one.
  */
 class DeclarationContainer
 {
@@ -44,7 +68,10 @@ public:
 		ASTNode const* _enclosingNode = nullptr,
 		DeclarationContainer const* _enclosingContainer = nullptr
 	):
-		m_enclosingNode(_enclosingNode), m_enclosingContainer(_enclosingContainer) {}
+		m_enclosingNode(_enclosingNode),
+		m_enclosingContainer(_enclosingContainer),
+		m_names(_enclosingContainer ? _enclosingContainer->m_names : std::make_shared<NameTable>())
+	{}
 	/// Registers the declaration in the scope unless its name is already declared or the name is empty.
 	/// @param _name the name to register, if nullptr the intrinsic name of @a _declaration is used.
 	/// @param _invisible if true, registers the declaration, reports name clashes but does not return it in @a resolveName
@@ -53,15 +80,24 @@ public:
 	bool registerDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr, bool _invisible = false, bool _update = false);
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations of this scope by the number of their name, in no
+	/// particular order. @see name
+	std::unordered_map<size_t, std::vector<Declaration const*>> const& declarationsByNameID() const { return m_declarations; }
+	/// @returns the name with the number @a _nameID.
+	ASTString const& name(size_t _nameID) const { return m_names->name(_nameID); }
+	/// @returns the visible declarations of this scope by name, sorted by name. This creates a
+	/// copy, use @a declarationsByNameID where the order does not matter.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
 private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::shared_ptr<NameTable> m_names;
+	/// Declarations by the number of their name in m_names.
+	std::unordered_map<size_t, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<size_t, std::vector<Declaration const*>> m_invisibleDeclarations;
 };
 
 }
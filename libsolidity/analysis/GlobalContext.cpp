@@ -25,6 +25,7 @@
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 using namespace std;
 
@@ -37,7 +38,7 @@ GlobalContext::GlobalContext():
 m_magicVariables(vector<shared_ptr<MagicVariableDeclaration const>>{make_shared<MagicVariableDeclaration>("block", make_shared<MagicType>(MagicType::Kind::Block)),
 					make_shared<MagicVariableDeclaration>("msg", make_shared<MagicType>(MagicType::Kind::Message)),
 					make_shared<MagicVariableDeclaration>("tx", make_shared<MagicType>(MagicType::Kind::Transaction)),
-					make_shared<MagicVariableDeclaration>("now", make_shared<IntegerType>(256)),
+					make_shared<MagicVariableDeclaration>("now", TypeProvider::uint256()),
 					make_shared<MagicVariableDeclaration>("suicide",
 							make_shared<FunctionType>(strings{"address"}, strings{}, FunctionType::Kind::Selfdestruct)),
 					make_shared<MagicVariableDeclaration>("selfdestruct",
@@ -106,5 +107,13 @@ MagicVariableDeclaration const* GlobalContext::currentSuper() const
 	return m_superPointer[m_currentContract].get();
 }
 
+void GlobalContext::removeContract(ContractDefinition const& _contract)
+{
+	m_thisPointer.erase(&_contract);
+	m_superPointer.erase(&_contract);
+	if (m_currentContract == &_contract)
+		m_currentContract = nullptr;
+}
+
 }
 }
@@ -29,6 +29,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 
 using namespace std;
@@ -39,11 +40,13 @@ class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
+	static size_t last() { return instance(); }
+	static void reset(size_t _lastID) { instance() = _lastID; }
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
+		// Compilations in different threads (e.g. in the compiler server) are numbered independently.
+		static thread_local IDDispenser dispenser;
 		return dispenser.id;
 	}
 	size_t id = 0;
@@ -57,19 +60,28 @@ ASTNode::ASTNode(SourceLocation const& _location):
 
 ASTNode::~ASTNode()
 {
-	delete m_annotation;
+	if (m_arena)
+		m_arena->forget(*this);
+	// Memory in the arena is released together with the arena.
+	if (m_arena && m_annotation)
+		m_annotation->~ASTAnnotation();
+	else
+		delete m_annotation;
+}
+
+void ASTNode::resetID(size_t _lastID)
+{
+	IDDispenser::reset(_lastID);
 }
 
-void ASTNode::resetID()
+size_t ASTNode::lastID()
 {
-	IDDispenser::reset();
+	return IDDispenser::last();
 }
 
 ASTAnnotation& ASTNode::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ASTAnnotation();
-	return *m_annotation;
+	return initAnnotation<ASTAnnotation>();
 }
 
 Error ASTNode::createTypeError(string const& _description) const
@@ -79,9 +91,7 @@ Error ASTNode::createTypeError(string const& _description) const
 
 SourceUnitAnnotation& SourceUnit::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new SourceUnitAnnotation();
-	return dynamic_cast<SourceUnitAnnotation&>(*m_annotation);
+	return initAnnotation<SourceUnitAnnotation>();
 }
 
 string Declaration::sourceUnitName() const
@@ -95,9 +105,7 @@ string Declaration::sourceUnitName() const
 
 ImportAnnotation& ImportDirective::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ImportAnnotation();
-	return dynamic_cast<ImportAnnotation&>(*m_annotation);
+	return initAnnotation<ImportAnnotation>();
 }
 
 TypePointer ImportDirective::type() const
@@ -106,6 +114,12 @@ TypePointer ImportDirective::type() const
 	return make_shared<ModuleType>(*annotation().sourceUnit);
 }
 
+uint64_t ContractDefinition::nextScopeID()
+{
+	static atomic<uint64_t> lastScopeID{0};
+	return ++lastScopeID;
+}
+
 map<FixedHash<4>, FunctionTypePointer> ContractDefinition::interfaceFunctions() const
 {
 	auto exportedFunctionList = interfaceFunctionList();
@@ -257,16 +271,12 @@ TypePointer ContractDefinition::type() const
 
 ContractDefinitionAnnotation& ContractDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ContractDefinitionAnnotation();
-	return dynamic_cast<ContractDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
 TypeNameAnnotation& TypeName::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeNameAnnotation();
-	return dynamic_cast<TypeNameAnnotation&>(*m_annotation);
+	return initAnnotation<TypeNameAnnotation>();
 }
 
 TypePointer StructDefinition::type() const
@@ -276,9 +286,7 @@ TypePointer StructDefinition::type() const
 
 TypeDeclarationAnnotation& StructDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeDeclarationAnnotation();
-	return dynamic_cast<TypeDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<TypeDeclarationAnnotation>();
 }
 
 TypePointer EnumValue::type() const
@@ -295,9 +303,7 @@ TypePointer EnumDefinition::type() const
 
 TypeDeclarationAnnotation& EnumDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new TypeDeclarationAnnotation();
-	return dynamic_cast<TypeDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<TypeDeclarationAnnotation>();
 }
 
 shared_ptr<FunctionType> FunctionDefinition::functionType(bool _internal) const
@@ -351,9 +357,7 @@ string FunctionDefinition::externalSignature() const
 
 FunctionDefinitionAnnotation& FunctionDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new FunctionDefinitionAnnotation();
-	return dynamic_cast<FunctionDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<FunctionDefinitionAnnotation>();
 }
 
 TypePointer ModifierDefinition::type() const
@@ -363,9 +367,7 @@ TypePointer ModifierDefinition::type() const
 
 ModifierDefinitionAnnotation& ModifierDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ModifierDefinitionAnnotation();
-	return dynamic_cast<ModifierDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<ModifierDefinitionAnnotation>();
 }
 
 TypePointer EventDefinition::type() const
@@ -383,16 +385,12 @@ std::shared_ptr<FunctionType> EventDefinition::functionType(bool _internal) cons
 
 EventDefinitionAnnotation& EventDefinition::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new EventDefinitionAnnotation();
-	return dynamic_cast<EventDefinitionAnnotation&>(*m_annotation);
+	return initAnnotation<EventDefinitionAnnotation>();
 }
 
 UserDefinedTypeNameAnnotation& UserDefinedTypeName::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new UserDefinedTypeNameAnnotation();
-	return dynamic_cast<UserDefinedTypeNameAnnotation&>(*m_annotation);
+	return initAnnotation<UserDefinedTypeNameAnnotation>();
 }
 
 bool VariableDeclaration::isLValue() const
@@ -462,72 +460,52 @@ shared_ptr<FunctionType> VariableDeclaration::functionType(bool _internal) const
 
 VariableDeclarationAnnotation& VariableDeclaration::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new VariableDeclarationAnnotation();
-	return dynamic_cast<VariableDeclarationAnnotation&>(*m_annotation);
+	return initAnnotation<VariableDeclarationAnnotation>();
 }
 
 StatementAnnotation& Statement::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new StatementAnnotation();
-	return dynamic_cast<StatementAnnotation&>(*m_annotation);
+	return initAnnotation<StatementAnnotation>();
 }
 
 InlineAssemblyAnnotation& InlineAssembly::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new InlineAssemblyAnnotation();
-	return dynamic_cast<InlineAssemblyAnnotation&>(*m_annotation);
+	return initAnnotation<InlineAssemblyAnnotation>();
 }
 
 ReturnAnnotation& Return::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ReturnAnnotation();
-	return dynamic_cast<ReturnAnnotation&>(*m_annotation);
+	return initAnnotation<ReturnAnnotation>();
 }
 
 VariableDeclarationStatementAnnotation& VariableDeclarationStatement::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new VariableDeclarationStatementAnnotation();
-	return dynamic_cast<VariableDeclarationStatementAnnotation&>(*m_annotation);
+	return initAnnotation<VariableDeclarationStatementAnnotation>();
 }
 
 ExpressionAnnotation& Expression::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new ExpressionAnnotation();
-	return dynamic_cast<ExpressionAnnotation&>(*m_annotation);
+	return initAnnotation<ExpressionAnnotation>();
 }
 
 MemberAccessAnnotation& MemberAccess::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new MemberAccessAnnotation();
-	return dynamic_cast<MemberAccessAnnotation&>(*m_annotation);
+	return initAnnotation<MemberAccessAnnotation>();
 }
 
 BinaryOperationAnnotation& BinaryOperation::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new BinaryOperationAnnotation();
-	return dynamic_cast<BinaryOperationAnnotation&>(*m_annotation);
+	return initAnnotation<BinaryOperationAnnotation>();
 }
 
 FunctionCallAnnotation& FunctionCall::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new FunctionCallAnnotation();
-	return dynamic_cast<FunctionCallAnnotation&>(*m_annotation);
+	return initAnnotation<FunctionCallAnnotation>();
 }
 
 IdentifierAnnotation& Identifier::annotation() const
 {
-	if (!m_annotation)
-		m_annotation = new IdentifierAnnotation();
-	return dynamic_cast<IdentifierAnnotation&>(*m_annotation);
+	return initAnnotation<IdentifierAnnotation>();
 }
 
 bool Literal::looksLikeAddress() const
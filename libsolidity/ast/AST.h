@@ -34,6 +34,7 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/ast/ASTAnnotations.h>
+#include <libsolidity/ast/ASTArena.h>
 #include <json/json.h>
 
 namespace dev
@@ -58,8 +59,11 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
-	static void resetID();
+	/// Resets the ID counter of the current thread such that the next node gets the ID
+	/// @a _lastID + 1. This invalidates all previous IDs.
+	static void resetID(size_t _lastID = 0);
+	/// @returns the ID of the node created last in the current thread.
+	static size_t lastID();
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -98,11 +102,30 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	/// @returns the annotation of this node, which is created upon first request inside the
+	/// arena of the node, if it has one.
+	template <class AnnotationType>
+	AnnotationType& initAnnotation() const
+	{
+		if (!m_annotation)
+		{
+			if (m_arena)
+				m_annotation = new (m_arena->allocate(sizeof(AnnotationType), alignof(AnnotationType))) AnnotationType();
+			else
+				m_annotation = new AnnotationType();
+		}
+		return dynamic_cast<AnnotationType&>(*m_annotation);
+	}
+
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable ASTAnnotation* m_annotation = nullptr;
 
 private:
+	friend class ASTArena;
+
+	/// The arena this node and its annotation are allocated in, if any.
+	ASTArena* m_arena = nullptr;
 	SourceLocation m_location;
 };
 
@@ -329,7 +352,8 @@ public:
 		Documented(_documentation),
 		m_baseContracts(_baseContracts),
 		m_subNodes(_subNodes),
-		m_contractKind(_contractKind)
+		m_contractKind(_contractKind),
+		m_scopeID(nextScopeID())
 	{}
 
 	virtual void accept(ASTVisitor& _visitor) override;
@@ -374,10 +398,17 @@ public:
 
 	ContractKind contractKind() const { return m_contractKind; }
 
+	/// @returns a number that identifies this contract as the scope of a member lookup. Unlike
+	/// its address and its ID, it is not reused by another contract during the process.
+	uint64_t scopeID() const { return m_scopeID; }
+
 private:
+	static uint64_t nextScopeID();
+
 	std::vector<ASTPointer<InheritanceSpecifier>> m_baseContracts;
 	std::vector<ASTPointer<ASTNode>> m_subNodes;
 	ContractKind m_contractKind;
+	uint64_t m_scopeID;
 
 	// parsed Natspec documentation of the contract.
 	Json::Value m_userDocumentation;
@@ -36,6 +36,7 @@ namespace solidity
 
 class Type;
 using TypePointer = std::shared_ptr<Type const>;
+class MemberList;
 
 struct ASTAnnotation
 {
@@ -87,6 +88,8 @@ struct ContractDefinitionAnnotation: TypeDeclarationAnnotation, DocumentedAnnota
 	/// List of contracts this contract creates, i.e. which need to be compiled first.
 	/// Also includes all contracts from @a linearizedBaseContracts.
 	std::set<ContractDefinition const*> contractDependencies;
+	/// Members of the types provided by TypeProvider in the scope of this contract.
+	std::map<Type const*, std::shared_ptr<MemberList const>> internedTypeMembers;
 };
 
 struct FunctionDefinitionAnnotation: ASTAnnotation, DocumentedAnnotation
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Region allocator for the nodes and annotations of a single source unit.
+ */
+
+#include <libsolidity/ast/ASTArena.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/Exceptions.h>
+
+#include <cstdint>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+size_t const ASTArena::c_chunkSize;
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	solAssert(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, "Invalid alignment.");
+	lock_guard<mutex> lock(m_mutex);
+
+	auto aligned = [&](char* _position)
+	{
+		uintptr_t address = reinterpret_cast<uintptr_t>(_position);
+		return _position + ((_alignment - address % _alignment) % _alignment);
+	};
+
+	char* position = m_position ? aligned(m_position) : nullptr;
+	if (!position || position + _size > m_end)
+	{
+		// Large objects get a chunk of their own so that the current chunk can still be used.
+		size_t chunkSize = max(c_chunkSize, _size + _alignment);
+		m_chunks.emplace_back(new char[chunkSize]);
+		m_capacity += chunkSize;
+		char* chunk = m_chunks.back().get();
+		position = aligned(chunk);
+		if (chunkSize > c_chunkSize)
+			return position;
+		m_end = chunk + chunkSize;
+	}
+	m_position = position + _size;
+	return position;
+}
+
+size_t ASTArena::capacity() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_capacity;
+}
+
+void ASTArena::recordNodes()
+{
+	m_recording = true;
+	m_nodes.clear();
+	m_firstRecordedID = ASTNode::lastID() + 1;
+}
+
+void ASTArena::shiftIDs(size_t _offset)
+{
+	for (ASTNode* node: m_nodes)
+		if (node)
+			node->m_id += _offset;
+	m_nodes.clear();
+	m_recording = false;
+}
+
+void ASTArena::forget(ASTNode const& _node)
+{
+	if (m_recording && _node.id() >= m_firstRecordedID && _node.id() - m_firstRecordedID < m_nodes.size())
+		m_nodes[_node.id() - m_firstRecordedID] = nullptr;
+}
+
+void ASTArena::record(ASTNode& _node)
+{
+	// The nodes need not be created in the order of their IDs, the binary AST loader does not.
+	solAssert(_node.id() >= m_firstRecordedID, "Node numbered before recording started.");
+	size_t index = _node.id() - m_firstRecordedID;
+	if (index >= m_nodes.size())
+		m_nodes.resize(index + 1, nullptr);
+	solAssert(!m_nodes[index], "Node ID used twice.");
+	m_nodes[index] = &_node;
+}
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Region allocator for the nodes and annotations of a single source unit.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+class ASTNode;
+
+/**
+ * Bump allocator that places the AST nodes of a source unit and their annotations contiguously
+ * in large chunks. Memory is never returned to the arena individually, all chunks are released
+ * at once together with the arena.
+ * Nodes created by @a create keep the arena alive through their control block, so the arena
+ * is destroyed only after the last node of the source unit.
+ */
+class ASTArena: public std::enable_shared_from_this<ASTArena>, private boost::noncopyable
+{
+public:
+	/// STL allocator that allocates from an arena and keeps it alive.
+	template <class T>
+	class Allocator
+	{
+	public:
+		using value_type = T;
+
+		explicit Allocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+		template <class U>
+		Allocator(Allocator<U> const& _other): m_arena(_other.m_arena) {}
+
+		T* allocate(std::size_t _n) { return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T))); }
+		void deallocate(T*, std::size_t) {}
+
+		template <class U>
+		bool operator==(Allocator<U> const& _other) const { return m_arena == _other.m_arena; }
+		template <class U>
+		bool operator!=(Allocator<U> const& _other) const { return m_arena != _other.m_arena; }
+
+	private:
+		template <class U> friend class Allocator;
+		std::shared_ptr<ASTArena> m_arena;
+	};
+
+	/// Creates an AST node of type @a NodeType inside the arena.
+	template <class NodeType, class... Args>
+	std::shared_ptr<NodeType> create(Args&&... _args)
+	{
+		auto node = std::allocate_shared<NodeType>(
+			Allocator<NodeType>(shared_from_this()),
+			std::forward<Args>(_args)...
+		);
+		node->m_arena = this;
+		if (m_recording)
+			record(*node);
+		return node;
+	}
+
+	/// Starts recording the nodes created in the arena, so that their IDs can be shifted
+	/// by @a shiftIDs once the number of nodes created before them is known. Used to parse
+	/// source units concurrently, each starting at ID one. Not safe to be called concurrently
+	/// with the creation or destruction of nodes.
+	void recordNodes();
+	/// Adds @a _offset to the IDs of all recorded nodes that still exist and stops recording.
+	void shiftIDs(std::size_t _offset);
+	/// Called by the destructor of the nodes in the arena.
+	void forget(ASTNode const& _node);
+
+	/// @returns @a _size bytes of uninitialised memory aligned to @a _alignment.
+	/// Safe to be called concurrently, annotations are also created lazily during code generation.
+	void* allocate(std::size_t _size, std::size_t _alignment);
+
+	/// @returns the number of bytes allocated from the operating system.
+	std::size_t capacity() const;
+
+private:
+	static std::size_t const c_chunkSize = 64 * 1024;
+
+	void record(ASTNode& _node);
+
+	mutable std::mutex m_mutex;
+	std::vector<std::unique_ptr<char[]>> m_chunks;
+	std::size_t m_capacity = 0;
+	char* m_position = nullptr;
+	char* m_end = nullptr;
+
+	bool m_recording = false;
+	/// Recorded nodes indexed by their ID minus the first ID, null if the node was destroyed
+	/// or the ID was not used.
+	std::vector<ASTNode*> m_nodes;
+	std::size_t m_firstRecordedID = 0;
+};
+
+}
+}
@@ -0,0 +1,1056 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Converts the AST of a source unit to and from a compact binary format.
+ */
+
+#include <libsolidity/ast/ASTBinaryConverter.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTArena.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/inlineasm/AsmParser.h>
+#include <libsolidity/interface/ErrorReporter.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/parsing/Scanner.h>
+
+#include <limits>
+#include <map>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+/// Changed whenever the encoding changes, the compiler version is stored in addition.
+unsigned const c_formatVersion = 1;
+char const c_magic[] = "solAST";
+
+/// Tags of the node types in the binary format.
+enum class NodeKind: uint8_t
+{
+	Null,
+	SourceUnit,
+	PragmaDirective,
+	ImportDirective,
+	ContractDefinition,
+	InheritanceSpecifier,
+	UsingForDirective,
+	StructDefinition,
+	EnumDefinition,
+	EnumValue,
+	ParameterList,
+	FunctionDefinition,
+	VariableDeclaration,
+	ModifierDefinition,
+	ModifierInvocation,
+	EventDefinition,
+	ElementaryTypeName,
+	UserDefinedTypeName,
+	FunctionTypeName,
+	Mapping,
+	ArrayTypeName,
+	InlineAssembly,
+	Block,
+	PlaceholderStatement,
+	IfStatement,
+	WhileStatement,
+	ForStatement,
+	Continue,
+	Break,
+	Return,
+	Throw,
+	VariableDeclarationStatement,
+	ExpressionStatement,
+	Conditional,
+	Assignment,
+	TupleExpression,
+	UnaryOperation,
+	BinaryOperation,
+	FunctionCall,
+	NewExpression,
+	MemberAccess,
+	IndexAccess,
+	Identifier,
+	ElementaryTypeNameExpression,
+	Literal,
+	NumKinds
+};
+
+struct BinaryASTError: virtual Exception {};
+
+/**
+ * Writes the nodes in pre-order. Every node starts with its kind, its ID relative to the source
+ * unit and its source location, followed by its own data and its children. Integers are
+ * variable-length encoded, strings are indices into a table that precedes the nodes.
+ */
+class BinaryASTWriter: private ASTConstVisitor
+{
+public:
+	bytes write(SourceUnit const& _sourceUnit, size_t _idCount)
+	{
+		m_rootID = _sourceUnit.id();
+		writeNode(_sourceUnit);
+
+		bytes header;
+		for (char const* c = c_magic; *c; ++c)
+			header.push_back(byte(*c));
+		writeNumber(header, c_formatVersion);
+		writeNumber(header, VersionString.size());
+		header += asBytes(VersionString);
+		// All IDs of the source unit are between the root ID and the root ID minus this number.
+		writeNumber(header, max(m_maxRelativeID + 1, _idCount));
+		writeNumber(header, m_strings.size());
+		for (string const* str: m_strings)
+		{
+			writeNumber(header, str->size());
+			header += asBytes(*str);
+		}
+		return header + m_data;
+	}
+
+private:
+	static void writeNumber(bytes& _data, size_t _value)
+	{
+		for (; _value >= 0x80; _value >>= 7)
+			_data.push_back(byte(_value | 0x80));
+		_data.push_back(byte(_value));
+	}
+	void writeNumber(size_t _value) { writeNumber(m_data, _value); }
+	void writeBool(bool _value) { writeNumber(_value ? 1 : 0); }
+	void writeToken(Token::Value _token) { writeNumber(unsigned(_token)); }
+	void writeString(ASTString const& _string)
+	{
+		auto inserted = m_stringIndices.insert(make_pair(_string, m_strings.size()));
+		if (inserted.second)
+			m_strings.push_back(&inserted.first->first);
+		writeNumber(inserted.first->second);
+	}
+	/// Writes zero for a missing string and the index plus one otherwise.
+	void writeOptionalString(ASTPointer<ASTString> const& _string)
+	{
+		if (!_string)
+			writeNumber(0);
+		else
+		{
+			writeNumber(1);
+			writeString(*_string);
+		}
+	}
+	void writeElementaryType(ElementaryTypeNameToken const& _type)
+	{
+		writeToken(_type.token());
+		writeNumber(_type.firstNumber());
+		writeNumber(_type.secondNumber());
+	}
+	void writeVisibility(Declaration::Visibility _visibility) { writeNumber(unsigned(_visibility)); }
+
+	void writeNode(ASTNode const* _node)
+	{
+		if (_node)
+			writeNode(*_node);
+		else
+			writeNumber(unsigned(NodeKind::Null));
+	}
+	void writeNode(ASTNode const& _node) { _node.accept(*this); }
+	template <class T>
+	void writeNodes(vector<ASTPointer<T>> const& _nodes)
+	{
+		writeNumber(_nodes.size());
+		for (auto const& node: _nodes)
+			writeNode(node.get());
+	}
+	void writeHeader(NodeKind _kind, ASTNode const& _node)
+	{
+		solAssert(_node.id() <= m_rootID, "");
+		size_t relativeID = m_rootID - _node.id();
+		m_maxRelativeID = max(m_maxRelativeID, relativeID);
+		writeNumber(unsigned(_kind));
+		writeNumber(relativeID);
+		writeNumber(_node.location().start + 1);
+		writeNumber(_node.location().end + 1);
+	}
+	void writeStatementHeader(NodeKind _kind, Statement const& _node)
+	{
+		writeHeader(_kind, _node);
+		writeOptionalString(_node.documentation());
+	}
+
+	bool visit(SourceUnit const& _node) override
+	{
+		writeHeader(NodeKind::SourceUnit, _node);
+		writeNodes(_node.nodes());
+		return false;
+	}
+	bool visit(PragmaDirective const& _node) override
+	{
+		writeHeader(NodeKind::PragmaDirective, _node);
+		writeNumber(_node.tokens().size());
+		for (Token::Value token: _node.tokens())
+			writeToken(token);
+		writeNumber(_node.literals().size());
+		for (ASTString const& literal: _node.literals())
+			writeString(literal);
+		return false;
+	}
+	bool visit(ImportDirective const& _node) override
+	{
+		writeHeader(NodeKind::ImportDirective, _node);
+		writeString(_node.path());
+		writeString(_node.name());
+		writeNumber(_node.symbolAliases().size());
+		for (auto const& alias: _node.symbolAliases())
+		{
+			writeNode(alias.first.get());
+			writeOptionalString(alias.second);
+		}
+		return false;
+	}
+	bool visit(ContractDefinition const& _node) override
+	{
+		writeHeader(NodeKind::ContractDefinition, _node);
+		writeString(_node.name());
+		writeOptionalString(_node.documentation());
+		writeNumber(unsigned(_node.contractKind()));
+		writeNodes(_node.baseContracts());
+		writeNodes(_node.subNodes());
+		return false;
+	}
+	bool visit(InheritanceSpecifier const& _node) override
+	{
+		writeHeader(NodeKind::InheritanceSpecifier, _node);
+		writeNode(_node.name());
+		writeNodes(_node.arguments());
+		return false;
+	}
+	bool visit(UsingForDirective const& _node) override
+	{
+		writeHeader(NodeKind::UsingForDirective, _node);
+		writeNode(_node.libraryName());
+		writeNode(_node.typeName());
+		return false;
+	}
+	bool visit(StructDefinition const& _node) override
+	{
+		writeHeader(NodeKind::StructDefinition, _node);
+		writeString(_node.name());
+		writeNodes(_node.members());
+		return false;
+	}
+	bool visit(EnumDefinition const& _node) override
+	{
+		writeHeader(NodeKind::EnumDefinition, _node);
+		writeString(_node.name());
+		writeNodes(_node.members());
+		return false;
+	}
+	bool visit(EnumValue const& _node) override
+	{
+		writeHeader(NodeKind::EnumValue, _node);
+		writeString(_node.name());
+		return false;
+	}
+	bool visit(ParameterList const& _node) override
+	{
+		writeHeader(NodeKind::ParameterList, _node);
+		writeNodes(_node.parameters());
+		return false;
+	}
+	bool visit(FunctionDefinition const& _node) override
+	{
+		writeHeader(NodeKind::FunctionDefinition, _node);
+		writeString(_node.name());
+		writeOptionalString(_node.documentation());
+		writeVisibility(_node.visibility());
+		writeBool(_node.isConstructor());
+		writeBool(_node.isDeclaredConst());
+		writeBool(_node.isPayable());
+		writeNode(_node.parameterList());
+		writeNodes(_node.modifiers());
+		writeNode(_node.returnParameterList().get());
+		writeNode(_node.isImplemented() ? &_node.body() : nullptr);
+		return false;
+	}
+	bool visit(VariableDeclaration const& _node) override
+	{
+		writeHeader(NodeKind::VariableDeclaration, _node);
+		writeString(_node.name());
+		writeVisibility(_node.visibility());
+		writeBool(_node.isStateVariable());
+		writeBool(_node.isIndexed());
+		writeBool(_node.isConstant());
+		writeNumber(unsigned(_node.referenceLocation()));
+		writeNode(_node.typeName());
+		writeNode(_node.value().get());
+		return false;
+	}
+	bool visit(ModifierDefinition const& _node) override
+	{
+		writeHeader(NodeKind::ModifierDefinition, _node);
+		writeString(_node.name());
+		writeOptionalString(_node.documentation());
+		writeNode(_node.parameterList());
+		writeNode(_node.body());
+		return false;
+	}
+	bool visit(ModifierInvocation const& _node) override
+	{
+		writeHeader(NodeKind::ModifierInvocation, _node);
+		writeNode(_node.name().get());
+		writeNodes(_node.arguments());
+		return false;
+	}
+	bool visit(EventDefinition const& _node) override
+	{
+		writeHeader(NodeKind::EventDefinition, _node);
+		writeString(_node.name());
+		writeOptionalString(_node.documentation());
+		writeBool(_node.isAnonymous());
+		writeNode(_node.parameterList());
+		return false;
+	}
+	bool visit(ElementaryTypeName const& _node) override
+	{
+		writeHeader(NodeKind::ElementaryTypeName, _node);
+		writeElementaryType(_node.typeName());
+		return false;
+	}
+	bool visit(UserDefinedTypeName const& _node) override
+	{
+		writeHeader(NodeKind::UserDefinedTypeName, _node);
+		writeNumber(_node.namePath().size());
+		for (ASTString const& name: _node.namePath())
+			writeString(name);
+		return false;
+	}
+	bool visit(FunctionTypeName const& _node) override
+	{
+		writeHeader(NodeKind::FunctionTypeName, _node);
+		writeVisibility(_node.visibility());
+		writeBool(_node.isDeclaredConst());
+		writeBool(_node.isPayable());
+		writeNode(_node.parameterTypeList().get());
+		writeNode(_node.returnParameterTypeList().get());
+		return false;
+	}
+	bool visit(Mapping const& _node) override
+	{
+		writeHeader(NodeKind::Mapping, _node);
+		writeNode(_node.keyType());
+		writeNode(_node.valueType());
+		return false;
+	}
+	bool visit(ArrayTypeName const& _node) override
+	{
+		writeHeader(NodeKind::ArrayTypeName, _node);
+		writeNode(_node.baseType());
+		writeNode(_node.length());
+		return false;
+	}
+	bool visit(InlineAssembly const& _node) override
+	{
+		// The block is parsed again from the source when reading.
+		writeStatementHeader(NodeKind::InlineAssembly, _node);
+		return false;
+	}
+	bool visit(Block const& _node) override
+	{
+		writeStatementHeader(NodeKind::Block, _node);
+		writeNodes(_node.statements());
+		return false;
+	}
+	bool visit(PlaceholderStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::PlaceholderStatement, _node);
+		return false;
+	}
+	bool visit(IfStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::IfStatement, _node);
+		writeNode(_node.condition());
+		writeNode(_node.trueStatement());
+		writeNode(_node.falseStatement());
+		return false;
+	}
+	bool visit(WhileStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::WhileStatement, _node);
+		writeBool(_node.isDoWhile());
+		writeNode(_node.condition());
+		writeNode(_node.body());
+		return false;
+	}
+	bool visit(ForStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::ForStatement, _node);
+		writeNode(_node.initializationExpression());
+		writeNode(_node.condition());
+		writeNode(_node.loopExpression());
+		writeNode(_node.body());
+		return false;
+	}
+	bool visit(Continue const& _node) override
+	{
+		writeStatementHeader(NodeKind::Continue, _node);
+		return false;
+	}
+	bool visit(Break const& _node) override
+	{
+		writeStatementHeader(NodeKind::Break, _node);
+		return false;
+	}
+	bool visit(Return const& _node) override
+	{
+		writeStatementHeader(NodeKind::Return, _node);
+		writeNode(_node.expression());
+		return false;
+	}
+	bool visit(Throw const& _node) override
+	{
+		writeStatementHeader(NodeKind::Throw, _node);
+		return false;
+	}
+	bool visit(VariableDeclarationStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::VariableDeclarationStatement, _node);
+		writeNodes(_node.declarations());
+		writeNode(_node.initialValue());
+		return false;
+	}
+	bool visit(ExpressionStatement const& _node) override
+	{
+		writeStatementHeader(NodeKind::ExpressionStatement, _node);
+		writeNode(_node.expression());
+		return false;
+	}
+	bool visit(Conditional const& _node) override
+	{
+		writeHeader(NodeKind::Conditional, _node);
+		writeNode(_node.condition());
+		writeNode(_node.trueExpression());
+		writeNode(_node.falseExpression());
+		return false;
+	}
+	bool visit(Assignment const& _node) override
+	{
+		writeHeader(NodeKind::Assignment, _node);
+		writeToken(_node.assignmentOperator());
+		writeNode(_node.leftHandSide());
+		writeNode(_node.rightHandSide());
+		return false;
+	}
+	bool visit(TupleExpression const& _node) override
+	{
+		writeHeader(NodeKind::TupleExpression, _node);
+		writeBool(_node.isInlineArray());
+		writeNodes(_node.components());
+		return false;
+	}
+	bool visit(UnaryOperation const& _node) override
+	{
+		writeHeader(NodeKind::UnaryOperation, _node);
+		writeToken(_node.getOperator());
+		writeBool(_node.isPrefixOperation());
+		writeNode(_node.subExpression());
+		return false;
+	}
+	bool visit(BinaryOperation const& _node) override
+	{
+		writeHeader(NodeKind::BinaryOperation, _node);
+		writeToken(_node.getOperator());
+		writeNode(_node.leftExpression());
+		writeNode(_node.rightExpression());
+		return false;
+	}
+	bool visit(FunctionCall const& _node) override
+	{
+		writeHeader(NodeKind::FunctionCall, _node);
+		writeNode(_node.expression());
+		writeNodes(_node.arguments());
+		writeNumber(_node.names().size());
+		for (auto const& name: _node.names())
+			writeString(*name);
+		return false;
+	}
+	bool visit(NewExpression const& _node) override
+	{
+		writeHeader(NodeKind::NewExpression, _node);
+		writeNode(_node.typeName());
+		return false;
+	}
+	bool visit(MemberAccess const& _node) override
+	{
+		writeHeader(NodeKind::MemberAccess, _node);
+		writeString(_node.memberName());
+		writeNode(_node.expression());
+		return false;
+	}
+	bool visit(IndexAccess const& _node) override
+	{
+		writeHeader(NodeKind::IndexAccess, _node);
+		writeNode(_node.baseExpression());
+		writeNode(_node.indexExpression());
+		return false;
+	}
+	bool visit(Identifier const& _node) override
+	{
+		writeHeader(NodeKind::Identifier, _node);
+		writeString(_node.name());
+		return false;
+	}
+	bool visit(ElementaryTypeNameExpression const& _node) override
+	{
+		writeHeader(NodeKind::ElementaryTypeNameExpression, _node);
+		writeElementaryType(_node.typeName());
+		return false;
+	}
+	bool visit(Literal const& _node) override
+	{
+		writeHeader(NodeKind::Literal, _node);
+		writeToken(_node.token());
+		writeNumber(unsigned(_node.subDenomination()));
+		writeString(_node.value());
+		return false;
+	}
+
+	bytes m_data;
+	size_t m_rootID = 0;
+	size_t m_maxRelativeID = 0;
+	map<ASTString, size_t> m_stringIndices;
+	vector<ASTString const*> m_strings;
+};
+
+/**
+ * Reads the format written by BinaryASTWriter. Every malformed input results in a BinaryASTError.
+ */
+class BinaryASTReader
+{
+public:
+	BinaryASTReader(bytesConstRef _data, Scanner const& _scanner, shared_ptr<ASTArena> const& _arena):
+		m_data(_data), m_scanner(_scanner), m_arena(_arena) {}
+
+	ASTPointer<SourceUnit> read()
+	{
+		for (char const* c = c_magic; *c; ++c)
+			if (readByte() != byte(*c))
+				return nullptr;
+		if (readNumber() != c_formatVersion)
+			return nullptr;
+		size_t versionLength = readNumber();
+		if (readBytes(versionLength) != VersionString)
+			return nullptr;
+		m_idCount = readNumber();
+		check(m_idCount <= numeric_limits<size_t>::max() - ASTNode::lastID());
+		m_lastID = ASTNode::lastID() + m_idCount;
+		size_t stringCount = readNumber();
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t length = readNumber();
+			string str = readBytes(length);
+			m_strings.push_back(
+				m_arena ?
+				allocate_shared<ASTString>(ASTArena::Allocator<ASTString>(m_arena), move(str)) :
+				make_shared<ASTString>(move(str))
+			);
+		}
+		ASTPointer<SourceUnit> sourceUnit = readNode<SourceUnit>();
+		check(sourceUnit && m_position == m_data.size());
+		ASTNode::resetID(m_lastID);
+		return sourceUnit;
+	}
+
+private:
+	static void check(bool _condition)
+	{
+		if (!_condition)
+			BOOST_THROW_EXCEPTION(BinaryASTError());
+	}
+
+	byte readByte()
+	{
+		check(m_position < m_data.size());
+		return m_data[m_position++];
+	}
+	string readBytes(size_t _length)
+	{
+		check(_length <= m_data.size() - m_position);
+		string result(reinterpret_cast<char const*>(m_data.data()) + m_position, _length);
+		m_position += _length;
+		return result;
+	}
+	size_t readNumber()
+	{
+		size_t value = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			check(shift < 64);
+			byte b = readByte();
+			value |= size_t(b & 0x7f) << shift;
+			if (!(b & 0x80))
+				return value;
+		}
+	}
+	bool readBool() { return readNumber() != 0; }
+	Token::Value readToken()
+	{
+		size_t token = readNumber();
+		check(token < Token::NUM_TOKENS);
+		return Token::Value(token);
+	}
+	ASTPointer<ASTString> const& readString()
+	{
+		size_t index = readNumber();
+		check(index < m_strings.size());
+		return m_strings[index];
+	}
+	ASTPointer<ASTString> readOptionalString()
+	{
+		return readBool() ? readString() : nullptr;
+	}
+	ElementaryTypeNameToken readElementaryType()
+	{
+		Token::Value token = readToken();
+		check(Token::isElementaryTypeName(token));
+		unsigned first = readNumber();
+		unsigned second = readNumber();
+		return ElementaryTypeNameToken(token, first, second);
+	}
+	Declaration::Visibility readVisibility()
+	{
+		size_t visibility = readNumber();
+		check(visibility <= unsigned(Declaration::Visibility::External));
+		return Declaration::Visibility(visibility);
+	}
+
+	template <class T>
+	ASTPointer<T> readNode()
+	{
+		ASTPointer<ASTNode> node = readAnyNode();
+		ASTPointer<T> result = dynamic_pointer_cast<T>(node);
+		check(!node || result);
+		return result;
+	}
+	template <class T>
+	ASTPointer<T> readRequiredNode()
+	{
+		ASTPointer<T> node = readNode<T>();
+		check(!!node);
+		return node;
+	}
+	template <class T>
+	vector<ASTPointer<T>> readNodes(bool _allowNull = false)
+	{
+		size_t count = readNumber();
+		vector<ASTPointer<T>> nodes;
+		for (size_t i = 0; i < count; ++i)
+		{
+			nodes.push_back(readNode<T>());
+			check(_allowNull || nodes.back());
+		}
+		return nodes;
+	}
+
+	/// Creates a node with the given relative ID in the arena.
+	template <class NodeType, class... Args>
+	ASTPointer<NodeType> create(size_t _relativeID, SourceLocation const& _location, Args&&... _args)
+	{
+		// The IDs below the range of this source belong to other sources.
+		check(_relativeID < m_idCount);
+		ASTNode::resetID(m_lastID - _relativeID - 1);
+		if (m_arena)
+			return m_arena->create<NodeType>(_location, forward<Args>(_args)...);
+		return make_shared<NodeType>(_location, forward<Args>(_args)...);
+	}
+
+	ASTPointer<InlineAssembly> readInlineAssembly(size_t _id, SourceLocation const& _location, ASTPointer<ASTString> const& _documentation)
+	{
+		// Inline assembly has its own syntax tree, it is parsed again at the original position
+		// so that its source locations are correct.
+		string const& source = m_scanner.source();
+		check(0 <= _location.start && _location.start <= _location.end && size_t(_location.end) <= source.size());
+		string text = string(_location.start, ' ') + source.substr(_location.start, _location.end - _location.start);
+		auto scanner = make_shared<Scanner>(CharStream(move(text)), *m_scanner.sourceName());
+		check(scanner->currentToken() == Token::Assembly);
+		if (scanner->next() == Token::StringLiteral)
+			scanner->next();
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		shared_ptr<assembly::Block> block = assembly::Parser(errorReporter).parse(scanner);
+		check(block && errors.empty());
+		return create<InlineAssembly>(_id, _location, _documentation, block);
+	}
+
+	ASTPointer<ASTNode> readAnyNode()
+	{
+		size_t kindNumber = readNumber();
+		check(kindNumber < size_t(NodeKind::NumKinds));
+		NodeKind kind = NodeKind(kindNumber);
+		if (kind == NodeKind::Null)
+			return nullptr;
+		size_t id = readNumber();
+		int start = int(readNumber()) - 1;
+		int end = int(readNumber()) - 1;
+		SourceLocation location(start, end, m_scanner.sourceName());
+
+		switch (kind)
+		{
+		case NodeKind::SourceUnit:
+		{
+			auto nodes = readNodes<ASTNode>();
+			return create<SourceUnit>(id, location, nodes);
+		}
+		case NodeKind::PragmaDirective:
+		{
+			vector<Token::Value> tokens(readNumber());
+			for (auto& token: tokens)
+				token = readToken();
+			size_t literalCount = readNumber();
+			vector<ASTString> literals;
+			for (size_t i = 0; i < literalCount; ++i)
+				literals.push_back(*readString());
+			check(tokens.size() == literals.size());
+			return create<PragmaDirective>(id, location, tokens, literals);
+		}
+		case NodeKind::ImportDirective:
+		{
+			auto path = readString();
+			auto unitAlias = readString();
+			size_t aliasCount = readNumber();
+			vector<pair<ASTPointer<Identifier>, ASTPointer<ASTString>>> symbolAliases;
+			for (size_t i = 0; i < aliasCount; ++i)
+			{
+				auto symbol = readRequiredNode<Identifier>();
+				symbolAliases.push_back(make_pair(symbol, readOptionalString()));
+			}
+			return create<ImportDirective>(id, location, path, unitAlias, move(symbolAliases));
+		}
+		case NodeKind::ContractDefinition:
+		{
+			auto name = readString();
+			auto documentation = readOptionalString();
+			size_t contractKind = readNumber();
+			check(contractKind <= unsigned(ContractDefinition::ContractKind::Library));
+			auto baseContracts = readNodes<InheritanceSpecifier>();
+			auto subNodes = readNodes<ASTNode>();
+			return create<ContractDefinition>(
+				id, location, name, documentation, baseContracts, subNodes,
+				ContractDefinition::ContractKind(contractKind)
+			);
+		}
+		case NodeKind::InheritanceSpecifier:
+		{
+			auto baseName = readRequiredNode<UserDefinedTypeName>();
+			auto arguments = readNodes<Expression>();
+			return create<InheritanceSpecifier>(id, location, baseName, arguments);
+		}
+		case NodeKind::UsingForDirective:
+		{
+			auto libraryName = readRequiredNode<UserDefinedTypeName>();
+			auto typeName = readNode<TypeName>();
+			return create<UsingForDirective>(id, location, libraryName, typeName);
+		}
+		case NodeKind::StructDefinition:
+		{
+			auto name = readString();
+			auto members = readNodes<VariableDeclaration>();
+			return create<StructDefinition>(id, location, name, members);
+		}
+		case NodeKind::EnumDefinition:
+		{
+			auto name = readString();
+			auto members = readNodes<EnumValue>();
+			return create<EnumDefinition>(id, location, name, members);
+		}
+		case NodeKind::EnumValue:
+			return create<EnumValue>(id, location, readString());
+		case NodeKind::ParameterList:
+		{
+			auto parameters = readNodes<VariableDeclaration>();
+			return create<ParameterList>(id, location, parameters);
+		}
+		case NodeKind::FunctionDefinition:
+		{
+			auto name = readString();
+			auto documentation = readOptionalString();
+			auto visibility = readVisibility();
+			bool isConstructor = readBool();
+			bool isDeclaredConst = readBool();
+			bool isPayable = readBool();
+			auto parameters = readRequiredNode<ParameterList>();
+			auto modifiers = readNodes<ModifierInvocation>();
+			auto returnParameters = readRequiredNode<ParameterList>();
+			auto body = readNode<Block>();
+			return create<FunctionDefinition>(
+				id, location, name, visibility, isConstructor, documentation, parameters,
+				isDeclaredConst, modifiers, returnParameters, isPayable, body
+			);
+		}
+		case NodeKind::VariableDeclaration:
+		{
+			auto name = readString();
+			auto visibility = readVisibility();
+			bool isStateVariable = readBool();
+			bool isIndexed = readBool();
+			bool isConstant = readBool();
+			size_t referenceLocation = readNumber();
+			check(referenceLocation <= VariableDeclaration::Memory);
+			auto typeName = readNode<TypeName>();
+			auto value = readNode<Expression>();
+			return create<VariableDeclaration>(
+				id, location, typeName, name, value, visibility, isStateVariable, isIndexed, isConstant,
+				VariableDeclaration::Location(referenceLocation)
+			);
+		}
+		case NodeKind::ModifierDefinition:
+		{
+			auto name = readString();
+			auto documentation = readOptionalString();
+			auto parameters = readRequiredNode<ParameterList>();
+			auto body = readRequiredNode<Block>();
+			return create<ModifierDefinition>(id, location, name, documentation, parameters, body);
+		}
+		case NodeKind::ModifierInvocation:
+		{
+			auto name = readRequiredNode<Identifier>();
+			auto arguments = readNodes<Expression>();
+			return create<ModifierInvocation>(id, location, name, arguments);
+		}
+		case NodeKind::EventDefinition:
+		{
+			auto name = readString();
+			auto documentation = readOptionalString();
+			bool isAnonymous = readBool();
+			auto parameters = readRequiredNode<ParameterList>();
+			return create<EventDefinition>(id, location, name, documentation, parameters, isAnonymous);
+		}
+		case NodeKind::ElementaryTypeName:
+			return create<ElementaryTypeName>(id, location, readElementaryType());
+		case NodeKind::UserDefinedTypeName:
+		{
+			size_t length = readNumber();
+			vector<ASTString> namePath;
+			for (size_t i = 0; i < length; ++i)
+				namePath.push_back(*readString());
+			return create<UserDefinedTypeName>(id, location, namePath);
+		}
+		case NodeKind::FunctionTypeName:
+		{
+			auto visibility = readVisibility();
+			bool isDeclaredConst = readBool();
+			bool isPayable = readBool();
+			auto parameterTypes = readRequiredNode<ParameterList>();
+			auto returnTypes = readRequiredNode<ParameterList>();
+			return create<FunctionTypeName>(id, location, parameterTypes, returnTypes, visibility, isDeclaredConst, isPayable);
+		}
+		case NodeKind::Mapping:
+		{
+			auto keyType = readRequiredNode<ElementaryTypeName>();
+			auto valueType = readRequiredNode<TypeName>();
+			return create<Mapping>(id, location, keyType, valueType);
+		}
+		case NodeKind::ArrayTypeName:
+		{
+			auto baseType = readRequiredNode<TypeName>();
+			auto length = readNode<Expression>();
+			return create<ArrayTypeName>(id, location, baseType, length);
+		}
+		case NodeKind::InlineAssembly:
+			return readInlineAssembly(id, location, readOptionalString());
+		case NodeKind::Block:
+		{
+			auto documentation = readOptionalString();
+			auto statements = readNodes<Statement>();
+			return create<Block>(id, location, documentation, statements);
+		}
+		case NodeKind::PlaceholderStatement:
+			return create<PlaceholderStatement>(id, location, readOptionalString());
+		case NodeKind::IfStatement:
+		{
+			auto documentation = readOptionalString();
+			auto condition = readRequiredNode<Expression>();
+			auto trueBody = readRequiredNode<Statement>();
+			auto falseBody = readNode<Statement>();
+			return create<IfStatement>(id, location, documentation, condition, trueBody, falseBody);
+		}
+		case NodeKind::WhileStatement:
+		{
+			auto documentation = readOptionalString();
+			bool isDoWhile = readBool();
+			auto condition = readRequiredNode<Expression>();
+			auto body = readRequiredNode<Statement>();
+			return create<WhileStatement>(id, location, documentation, condition, body, isDoWhile);
+		}
+		case NodeKind::ForStatement:
+		{
+			auto documentation = readOptionalString();
+			auto initialization = readNode<Statement>();
+			auto condition = readNode<Expression>();
+			auto loopExpression = readNode<ExpressionStatement>();
+			auto body = readRequiredNode<Statement>();
+			return create<ForStatement>(id, location, documentation, initialization, condition, loopExpression, body);
+		}
+		case NodeKind::Continue:
+			return create<Continue>(id, location, readOptionalString());
+		case NodeKind::Break:
+			return create<Break>(id, location, readOptionalString());
+		case NodeKind::Return:
+		{
+			auto documentation = readOptionalString();
+			auto expression = readNode<Expression>();
+			return create<Return>(id, location, documentation, expression);
+		}
+		case NodeKind::Throw:
+			return create<Throw>(id, location, readOptionalString());
+		case NodeKind::VariableDeclarationStatement:
+		{
+			auto documentation = readOptionalString();
+			auto declarations = readNodes<VariableDeclaration>(true);
+			auto initialValue = readNode<Expression>();
+			return create<VariableDeclarationStatement>(id, location, documentation, declarations, initialValue);
+		}
+		case NodeKind::ExpressionStatement:
+		{
+			auto documentation = readOptionalString();
+			auto expression = readRequiredNode<Expression>();
+			return create<ExpressionStatement>(id, location, documentation, expression);
+		}
+		case NodeKind::Conditional:
+		{
+			auto condition = readRequiredNode<Expression>();
+			auto trueExpression = readRequiredNode<Expression>();
+			auto falseExpression = readRequiredNode<Expression>();
+			return create<Conditional>(id, location, condition, trueExpression, falseExpression);
+		}
+		case NodeKind::Assignment:
+		{
+			Token::Value assignmentOperator = readToken();
+			check(Token::isAssignmentOp(assignmentOperator));
+			auto leftHandSide = readRequiredNode<Expression>();
+			auto rightHandSide = readRequiredNode<Expression>();
+			return create<Assignment>(id, location, leftHandSide, assignmentOperator, rightHandSide);
+		}
+		case NodeKind::TupleExpression:
+		{
+			bool isInlineArray = readBool();
+			auto components = readNodes<Expression>(true);
+			return create<TupleExpression>(id, location, components, isInlineArray);
+		}
+		case NodeKind::UnaryOperation:
+		{
+			Token::Value unaryOperator = readToken();
+			check(Token::isUnaryOp(unaryOperator));
+			bool isPrefix = readBool();
+			auto subExpression = readRequiredNode<Expression>();
+			return create<UnaryOperation>(id, location, unaryOperator, subExpression, isPrefix);
+		}
+		case NodeKind::BinaryOperation:
+		{
+			Token::Value binaryOperator = readToken();
+			check(Token::isBinaryOp(binaryOperator) || Token::isCompareOp(binaryOperator));
+			auto left = readRequiredNode<Expression>();
+			auto right = readRequiredNode<Expression>();
+			return create<BinaryOperation>(id, location, left, binaryOperator, right);
+		}
+		case NodeKind::FunctionCall:
+		{
+			auto expression = readRequiredNode<Expression>();
+			auto arguments = readNodes<Expression>();
+			size_t nameCount = readNumber();
+			vector<ASTPointer<ASTString>> names;
+			for (size_t i = 0; i < nameCount; ++i)
+				names.push_back(readString());
+			return create<FunctionCall>(id, location, expression, arguments, names);
+		}
+		case NodeKind::NewExpression:
+			return create<NewExpression>(id, location, readRequiredNode<TypeName>());
+		case NodeKind::MemberAccess:
+		{
+			auto memberName = readString();
+			auto expression = readRequiredNode<Expression>();
+			return create<MemberAccess>(id, location, expression, memberName);
+		}
+		case NodeKind::IndexAccess:
+		{
+			auto base = readRequiredNode<Expression>();
+			auto index = readNode<Expression>();
+			return create<IndexAccess>(id, location, base, index);
+		}
+		case NodeKind::Identifier:
+			return create<Identifier>(id, location, readString());
+		case NodeKind::ElementaryTypeNameExpression:
+			return create<ElementaryTypeNameExpression>(id, location, readElementaryType());
+		case NodeKind::Literal:
+		{
+			Token::Value token = readToken();
+			Token::Value subDenomination = readToken();
+			check(
+				subDenomination == Token::Illegal ||
+				Token::isEtherSubdenomination(subDenomination) ||
+				Token::isTimeSubdenomination(subDenomination)
+			);
+			auto value = readString();
+			return create<Literal>(id, location, token, value, Literal::SubDenomination(subDenomination));
+		}
+		default:
+			check(false);
+			return nullptr;
+		}
+	}
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	Scanner const& m_scanner;
+	shared_ptr<ASTArena> m_arena;
+	/// The number of IDs used by the source and the last of them.
+	size_t m_idCount = 0;
+	size_t m_lastID = 0;
+	vector<ASTPointer<ASTString>> m_strings;
+};
+
+}
+
+bytes ASTBinaryConverter::toBinary(SourceUnit const& _sourceUnit, size_t _idCount)
+{
+	return BinaryASTWriter().write(_sourceUnit, _idCount);
+}
+
+ASTPointer<SourceUnit> ASTBinaryConverter::fromBinary(
+	bytesConstRef _data,
+	Scanner const& _scanner,
+	shared_ptr<ASTArena> const& _arena
+)
+{
+	size_t lastID = ASTNode::lastID();
+	try
+	{
+		ASTPointer<SourceUnit> sourceUnit = BinaryASTReader(_data, _scanner, _arena).read();
+		if (sourceUnit)
+			return sourceUnit;
+	}
+	catch (BinaryASTError const&)
+	{
+	}
+	catch (InternalCompilerError const&)
+	{
+		// Raised by the assertions in the constructors of the nodes.
+	}
+	ASTNode::resetID(lastID);
+	return nullptr;
+}
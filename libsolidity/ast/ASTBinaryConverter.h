@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Converts the AST of a source unit to and from a compact binary format.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <libdevcore/Common.h>
+
+#include <memory>
+
+namespace dev
+{
+namespace solidity
+{
+
+class ASTArena;
+class Scanner;
+
+/**
+ * Compact binary serialisation of the AST of a source unit as it is produced by the parser, used
+ * to skip scanning and parsing of sources that did not change. Only the syntactic structure is
+ * stored: the annotations refer to other source units and to the types of a compilation, so they
+ * are recomputed by the analysis of the loaded source unit.
+ * Every string is stored once per source unit and the loaded nodes get the same IDs relative to
+ * each other as the stored ones.
+ */
+class ASTBinaryConverter
+{
+public:
+	/// @returns the binary representation of @a _sourceUnit. @a _idCount is the number of IDs
+	/// used by the parser for the source unit, so that a loaded source unit uses as many, it
+	/// defaults to the range of IDs of the nodes.
+	static bytes toBinary(SourceUnit const& _sourceUnit, size_t _idCount = 0);
+	/// Rebuilds a source unit from @a _data. @a _scanner has to contain the source the data was
+	/// created from, it provides the source name and inline assembly blocks are parsed again.
+	/// The nodes are created in @a _arena if given and are numbered after the current value of
+	/// the ID counter of this thread, which is advanced past them.
+	/// @returns null if @a _data was created by a different compiler version or is corrupt.
+	static ASTPointer<SourceUnit> fromBinary(
+		bytesConstRef _data,
+		Scanner const& _scanner,
+		std::shared_ptr<ASTArena> const& _arena = nullptr
+	);
+};
+
+}
+}
@@ -24,6 +24,8 @@
 
 #include <ostream>
 #include <stack>
+#include <vector>
+#include <algorithm>
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/ast/ASTAnnotations.h>
@@ -140,14 +142,20 @@ private:
 		return _node.id();
 	}
 	template<class Container>
-	Json::Value getContainerIds(Container const& container)
+	Json::Value getContainerIds(Container const& _container, bool _order = false)
 	{
-		Json::Value tmp(Json::arrayValue);
-		for (auto const& element: container)
+		std::vector<int> ids;
+		for (auto const& element: _container)
 		{
 			solAssert(element, "");
-			tmp.append(nodeId(*element));
+			ids.push_back(nodeId(*element));
 		}
+		// Sets of pointers are ordered by address, which differs between runs.
+		if (_order)
+			std::sort(ids.begin(), ids.end());
+		Json::Value tmp(Json::arrayValue);
+		for (int id: ids)
+			tmp.append(id);
 		return tmp;
 	}
 	Json::Value typePointerToJson(TypePointer _tp);
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Interned instances of the types that do not depend on the AST.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+shared_ptr<BoolType const> const& TypeProvider::boolean()
+{
+	static shared_ptr<BoolType const> const type = create<BoolType>();
+	return type;
+}
+
+shared_ptr<IntegerType const> const& TypeProvider::integer(int _bits, IntegerType::Modifier _modifier)
+{
+	static shared_ptr<IntegerType const> const addressType = create<IntegerType>(160, IntegerType::Modifier::Address);
+	// Unsigned types followed by signed types, ordered by size.
+	static vector<shared_ptr<IntegerType const>> const integerTypes = []()
+	{
+		vector<shared_ptr<IntegerType const>> types;
+		for (auto modifier: {IntegerType::Modifier::Unsigned, IntegerType::Modifier::Signed})
+			for (int bits = 8; bits <= 256; bits += 8)
+				types.push_back(create<IntegerType>(bits, modifier));
+		return types;
+	}();
+
+	if (_modifier == IntegerType::Modifier::Address)
+		return addressType;
+	solAssert(
+		_bits > 0 && _bits <= 256 && _bits % 8 == 0,
+		"Invalid bit number for integer type: " + dev::toString(_bits)
+	);
+	return integerTypes[(_modifier == IntegerType::Modifier::Signed ? 32 : 0) + _bits / 8 - 1];
+}
+
+shared_ptr<FixedBytesType const> const& TypeProvider::fixedBytes(int _bytes)
+{
+	static vector<shared_ptr<FixedBytesType const>> const fixedBytesTypes = []()
+	{
+		vector<shared_ptr<FixedBytesType const>> types;
+		for (int bytes = 0; bytes <= 32; ++bytes)
+			types.push_back(create<FixedBytesType>(bytes));
+		return types;
+	}();
+
+	solAssert(
+		_bytes >= 0 && _bytes <= 32,
+		"Invalid byte number for fixed bytes type: " + dev::toString(_bytes)
+	);
+	return fixedBytesTypes[_bytes];
+}
+
+shared_ptr<FixedPointType const> TypeProvider::fixedPoint(
+	int _integerBits,
+	int _fractionalBits,
+	FixedPointType::Modifier _modifier
+)
+{
+	// There are too many fixed point types to create all of them in advance.
+	static mutex fixedPointMutex;
+	static map<tuple<int, int, FixedPointType::Modifier>, shared_ptr<FixedPointType const>> fixedPointTypes;
+
+	lock_guard<mutex> lock(fixedPointMutex);
+	auto& type = fixedPointTypes[make_tuple(_integerBits, _fractionalBits, _modifier)];
+	if (!type)
+		type = create<FixedPointType>(_integerBits, _fractionalBits, _modifier);
+	return type;
+}
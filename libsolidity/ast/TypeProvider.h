@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Interned instances of the types that do not depend on the AST.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+
+#include <memory>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Provides the elementary types, which do not refer to the AST. Every distinct type exists only
+ * once and is shared by all compilations, so it is not allocated again whenever it is needed,
+ * its member lists are computed only once and it is compared to other types by its address.
+ * These types can only be created here.
+ * Members that depend on a contract scope (i.e. bound functions) are stored with the contract.
+ */
+class TypeProvider
+{
+public:
+	static std::shared_ptr<BoolType const> const& boolean();
+	/// @returns the integer type with @a _bits bits or the address type.
+	static std::shared_ptr<IntegerType const> const& integer(
+		int _bits,
+		IntegerType::Modifier _modifier = IntegerType::Modifier::Unsigned
+	);
+	static std::shared_ptr<IntegerType const> const& uint256() { return integer(256); }
+	static std::shared_ptr<IntegerType const> const& address() { return integer(160, IntegerType::Modifier::Address); }
+	static std::shared_ptr<FixedBytesType const> const& fixedBytes(int _bytes);
+	static std::shared_ptr<FixedPointType const> fixedPoint(
+		int _integerBits,
+		int _fractionalBits,
+		FixedPointType::Modifier _modifier = FixedPointType::Modifier::Unsigned
+	);
+
+private:
+	/// Creates an instance of @a T that is marked as shared.
+	template <class T, class... Args>
+	static std::shared_ptr<T const> create(Args&&... _args)
+	{
+		// The constructors are private, so make_shared cannot be used.
+		std::shared_ptr<T> type(new T(std::forward<Args>(_args)...));
+		type->m_interned = true;
+		return type;
+	}
+};
+
+}
+}
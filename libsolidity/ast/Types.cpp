@@ -23,6 +23,7 @@
 #include <libsolidity/ast/Types.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/CommonData.h>
@@ -37,6 +38,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 
 #include <limits>
+#include <mutex>
 
 using namespace std;
 using namespace dev;
@@ -89,9 +91,10 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 MemberList& MemberList::operator=(MemberList&& _other)
 {
 	assert(&_other != this);
+	// The storage offsets of this list are computed only once.
+	assert(!m_storageOffsets);
 
 	m_memberTypes = move(_other.m_memberTypes);
-	m_storageOffsets = move(_other.m_storageOffsets);
 	return *this;
 }
 
@@ -102,15 +105,16 @@ void MemberList::combine(MemberList const & _other)
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
-	if (!m_storageOffsets)
+	call_once(m_storageOffsetsComputed, [&]()
 	{
 		TypePointers memberTypes;
 		memberTypes.reserve(m_memberTypes.size());
 		for (auto const& member: m_memberTypes)
 			memberTypes.push_back(member.type);
-		m_storageOffsets.reset(new StorageOffsets());
-		m_storageOffsets->computeOffsets(memberTypes);
-	}
+		unique_ptr<StorageOffsets> offsets(new StorageOffsets());
+		offsets->computeOffsets(memberTypes);
+		m_storageOffsets = move(offsets);
+	});
 	for (size_t index = 0; index < m_memberTypes.size(); ++index)
 		if (m_memberTypes[index].name == _name)
 			return m_storageOffsets->offset(index);
@@ -182,29 +186,29 @@ TypePointer Type::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
 	switch (token)
 	{
 	case Token::IntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(m, IntegerType::Modifier::Signed);
 	case Token::UIntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(m, IntegerType::Modifier::Unsigned);
 	case Token::BytesM:
-		return make_shared<FixedBytesType>(m);
+		return TypeProvider::fixedBytes(m);
 	case Token::FixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Signed);
 	case Token::UFixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Unsigned);
 	case Token::Int:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(256, IntegerType::Modifier::Signed);
 	case Token::UInt:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 	case Token::Fixed:
-		return make_shared<FixedPointType>(128, 128, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(128, 128, FixedPointType::Modifier::Signed);
 	case Token::UFixed:
-		return make_shared<FixedPointType>(128, 128, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(128, 128, FixedPointType::Modifier::Unsigned);
 	case Token::Byte:
-		return make_shared<FixedBytesType>(1);
+		return TypeProvider::fixedBytes(1);
 	case Token::Address:
-		return make_shared<IntegerType>(0, IntegerType::Modifier::Address);
+		return TypeProvider::address();
 	case Token::Bool:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Bytes:
 		return make_shared<ArrayType>(DataLocation::Storage);
 	case Token::String:
@@ -232,7 +236,7 @@ TypePointer Type::forLiteral(Literal const& _literal)
 	{
 	case Token::TrueLiteral:
 	case Token::FalseLiteral:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Number:
 	{
 		tuple<bool, rational> validLiteral = RationalNumberType::isValidLiteral(_literal);
@@ -262,14 +266,29 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
-	if (!m_members[_currentScope])
+	if (!_currentScope)
+	{
+		call_once(m_unscopedMembersComputed, [&]()
+		{
+			m_unscopedMembers = make_shared<MemberList const>(nativeMembers(nullptr));
+		});
+		return *m_unscopedMembers;
+	}
+	// Members in the scope of a contract are only requested while analysing the contract,
+	// which is not done concurrently.
+	// Interned types outlive the AST, so their members in the scope of a contract
+	// (which include the bound functions) are stored with the contract.
+	shared_ptr<MemberList const>& memberList =
+		m_interned ?
+		_currentScope->annotation().internedTypeMembers[this] :
+		m_members[_currentScope->scopeID()];
+	if (!memberList)
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = unique_ptr<MemberList>(new MemberList(move(members)));
+		members += boundFunctions(*this, *_currentScope);
+		memberList = make_shared<MemberList const>(move(members));
 	}
-	return *m_members[_currentScope];
+	return *memberList;
 }
 
 MemberList::MemberMap Type::boundFunctions(Type const& _type, ContractDefinition const& _scope)
@@ -389,14 +408,6 @@ TypePointer IntegerType::unaryOperatorResult(Token::Value _operator) const
 		return TypePointer();
 }
 
-bool IntegerType::operator==(Type const& _other) const
-{
-	if (_other.category() != category())
-		return false;
-	IntegerType const& other = dynamic_cast<IntegerType const&>(_other);
-	return other.m_bits == m_bits && other.m_modifier == m_modifier;
-}
-
 string IntegerType::toString(bool) const
 {
 	if (isAddress())
@@ -460,7 +471,7 @@ MemberList::MemberMap IntegerType::nativeMembers(ContractDefinition const*) cons
 {
 	if (isAddress())
 		return {
-			{"balance", make_shared<IntegerType >(256)},
+			{"balance", TypeProvider::uint256()},
 			{"call", make_shared<FunctionType>(strings(), strings{"bool"}, FunctionType::Kind::Bare, true, false, true)},
 			{"callcode", make_shared<FunctionType>(strings(), strings{"bool"}, FunctionType::Kind::BareCallCode, true, false, true)},
 			{"delegatecall", make_shared<FunctionType>(strings(), strings{"bool"}, FunctionType::Kind::BareDelegateCall, true)},
@@ -528,14 +539,6 @@ TypePointer FixedPointType::unaryOperatorResult(Token::Value _operator) const
 		return TypePointer();
 }
 
-bool FixedPointType::operator==(Type const& _other) const
-{
-	if (_other.category() != category())
-		return false;
-	FixedPointType const& other = dynamic_cast<FixedPointType const&>(_other);
-	return other.m_integerBits == m_integerBits && other.m_fractionalBits == m_fractionalBits && other.m_modifier == m_modifier;
-}
-
 string FixedPointType::toString(bool) const
 {
 	string prefix = isSigned() ? "fixed" : "ufixed";
@@ -909,7 +912,7 @@ string RationalNumberType::identifier() const
 	return "t_rational_" + m_value.numerator().str() + "_by_" + m_value.denominator().str();
 }
 
-bool RationalNumberType::operator==(Type const& _other) const
+bool RationalNumberType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -972,7 +975,7 @@ shared_ptr<IntegerType const> RationalNumberType::integerType() const
 	if (value > u256(-1))
 		return shared_ptr<IntegerType const>();
 	else
-		return make_shared<IntegerType>(
+		return TypeProvider::integer(
 			max(bytesRequired(value), 1u) * 8,
 			negative ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned
 		);
@@ -1024,7 +1027,7 @@ shared_ptr<FixedPointType const> RationalNumberType::fixedPointType() const
 		fractionalBits = 8;
 	}
 
-	return make_shared<FixedPointType>(
+	return TypeProvider::fixedPoint(
 		integerBits, fractionalBits,
 		negative ? FixedPointType::Modifier::Signed : FixedPointType::Modifier::Unsigned
 	);
@@ -1055,7 +1058,7 @@ string StringLiteralType::identifier() const
 	return "t_stringliteral_" + toHex(keccak256(m_value).asBytes());
 }
 
-bool StringLiteralType::operator==(const Type& _other) const
+bool StringLiteralType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -1082,11 +1085,11 @@ bool StringLiteralType::isValidUTF8() const
 	return dev::validateUTF8(m_value);
 }
 
-shared_ptr<FixedBytesType> FixedBytesType::smallestTypeForLiteral(string const& _literal)
+shared_ptr<FixedBytesType const> FixedBytesType::smallestTypeForLiteral(string const& _literal)
 {
 	if (_literal.length() <= 32)
-		return make_shared<FixedBytesType>(_literal.length());
-	return shared_ptr<FixedBytesType>();
+		return TypeProvider::fixedBytes(_literal.length());
+	return shared_ptr<FixedBytesType const>();
 }
 
 FixedBytesType::FixedBytesType(int _bytes): m_bytes(_bytes)
@@ -1145,7 +1148,7 @@ TypePointer FixedBytesType::binaryOperatorResult(Token::Value _operator, TypePoi
 
 MemberList::MemberMap FixedBytesType::nativeMembers(const ContractDefinition*) const
 {
-	return MemberList::MemberMap{MemberList::Member{"length", make_shared<IntegerType>(8)}};
+	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::integer(8)}};
 }
 
 string FixedBytesType::identifier() const
@@ -1153,14 +1156,6 @@ string FixedBytesType::identifier() const
 	return "t_bytes" + std::to_string(m_bytes);
 }
 
-bool FixedBytesType::operator==(Type const& _other) const
-{
-	if (_other.category() != category())
-		return false;
-	FixedBytesType const& other = dynamic_cast<FixedBytesType const&>(_other);
-	return other.m_bytes == m_bytes;
-}
-
 u256 BoolType::literalValue(Literal const* _literal) const
 {
 	solAssert(_literal, "");
@@ -1214,6 +1209,11 @@ bool ContractType::isExplicitlyConvertibleTo(Type const& _convertTo) const
 		_convertTo.category() == Category::Contract;
 }
 
+TypePointer ContractType::encodingType() const
+{
+	return TypeProvider::address();
+}
+
 TypePointer ContractType::unaryOperatorResult(Token::Value _operator) const
 {
 	return _operator == Token::Delete ? make_shared<TupleType>() : TypePointer();
@@ -1280,6 +1280,13 @@ string ReferenceType::identifierLocationSuffix() const
 	return id;
 }
 
+ArrayType::ArrayType(DataLocation _location, bool _isString):
+	ReferenceType(_location),
+	m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
+	m_baseType(TypeProvider::fixedBytes(1))
+{
+}
+
 bool ArrayType::isImplicitlyConvertibleTo(const Type& _convertTo) const
 {
 	if (_convertTo.category() != category())
@@ -1356,13 +1363,13 @@ string ArrayType::identifier() const
 	return id;
 }
 
-bool ArrayType::operator==(Type const& _other) const
+bool ArrayType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
 	if (
-		!ReferenceType::operator==(other) ||
+		!hasSameLocation(other) ||
 		other.isByteArray() != isByteArray() ||
 		other.isString() != isString() ||
 		other.isDynamicallySized() != isDynamicallySized()
@@ -1458,11 +1465,11 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 	MemberList::MemberMap members;
 	if (!isString())
 	{
-		members.push_back({"length", make_shared<IntegerType>(256)});
+		members.push_back({"length", TypeProvider::uint256()});
 		if (isDynamicallySized() && location() == DataLocation::Storage)
 			members.push_back({"push", make_shared<FunctionType>(
 				TypePointers{baseType()},
-				TypePointers{make_shared<IntegerType>(256)},
+				TypePointers{TypeProvider::uint256()},
 				strings{string()},
 				strings{string()},
 				isByteArray() ? FunctionType::Kind::ByteArrayPush : FunctionType::Kind::ArrayPush
@@ -1474,7 +1481,7 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 TypePointer ArrayType::encodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return this->copyForLocation(DataLocation::Memory, true);
 }
@@ -1482,7 +1489,7 @@ TypePointer ArrayType::encodingType() const
 TypePointer ArrayType::decodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return shared_from_this();
 }
@@ -1547,7 +1554,7 @@ string ContractType::identifier() const
 	return (m_super ? "t_super" : "t_contract") + parenthesizeUserIdentifier(m_contract.name()) + std::to_string(m_contract.id());
 }
 
-bool ContractType::operator==(Type const& _other) const
+bool ContractType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -1571,7 +1578,7 @@ string ContractType::canonicalName(bool) const
 MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const*) const
 {
 	// All address members and all interface functions
-	MemberList::MemberMap members(IntegerType(120, IntegerType::Modifier::Address).nativeMembers(nullptr));
+	MemberList::MemberMap members(TypeProvider::address()->nativeMembers(nullptr));
 	if (m_super)
 	{
 		// add the most derived of all functions which are visible in derived contracts
@@ -1618,8 +1625,10 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const*) con
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
-	if (!m_constructorType)
+	call_once(m_constructorTypeComputed, [&]()
+	{
 		m_constructorType = FunctionType::newExpressionType(m_contract);
+	});
 	return m_constructorType;
 }
 
@@ -1661,12 +1670,12 @@ string StructType::identifier() const
 	return "t_struct" + parenthesizeUserIdentifier(m_struct.name()) + std::to_string(m_struct.id()) + identifierLocationSuffix();
 }
 
-bool StructType::operator==(Type const& _other) const
+bool StructType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
 	StructType const& other = dynamic_cast<StructType const&>(_other);
-	return ReferenceType::operator==(other) && other.m_struct == m_struct;
+	return hasSameLocation(other) && other.m_struct == m_struct;
 }
 
 unsigned StructType::calldataEncodedSize(bool _padded) const
@@ -1726,6 +1735,11 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 	return members;
 }
 
+TypePointer StructType::encodingType() const
+{
+	return location() == DataLocation::Storage ? TypeProvider::uint256() : TypePointer();
+}
+
 TypePointer StructType::interfaceType(bool _inLibrary) const
 {
 	if (_inLibrary && location() == DataLocation::Storage)
@@ -1797,6 +1811,11 @@ set<string> StructType::membersMissingInMemory() const
 	return missing;
 }
 
+TypePointer EnumType::encodingType() const
+{
+	return TypeProvider::integer(8 * int(storageBytes()));
+}
+
 TypePointer EnumType::unaryOperatorResult(Token::Value _operator) const
 {
 	return _operator == Token::Delete ? make_shared<TupleType>() : TypePointer();
@@ -1807,7 +1826,7 @@ string EnumType::identifier() const
 	return "t_enum" + parenthesizeUserIdentifier(m_enum.name()) + std::to_string(m_enum.id());
 }
 
-bool EnumType::operator==(Type const& _other) const
+bool EnumType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -1893,7 +1912,7 @@ string TupleType::identifier() const
 	return "t_tuple" + identifierList(components());
 }
 
-bool TupleType::operator==(Type const& _other) const
+bool TupleType::equals(Type const& _other) const
 {
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
 		return components() == tupleType->components();
@@ -2018,7 +2037,7 @@ FunctionType::FunctionType(VariableDeclaration const& _varDecl):
 				break;
 			returnType = arrayType->baseType();
 			paramNames.push_back("");
-			paramTypes.push_back(make_shared<IntegerType>(256));
+			paramTypes.push_back(TypeProvider::uint256());
 		}
 		else
 			break;
@@ -2198,7 +2217,7 @@ string FunctionType::identifier() const
 	return id;
 }
 
-bool FunctionType::operator==(Type const& _other) const
+bool FunctionType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2633,12 +2652,17 @@ ASTPointer<ASTString> FunctionType::documentation() const
 	return ASTPointer<ASTString>();
 }
 
+TypePointer MappingType::encodingType() const
+{
+	return TypeProvider::uint256();
+}
+
 string MappingType::identifier() const
 {
 	return "t_mapping" + identifierList(m_keyType, m_valueType);
 }
 
-bool MappingType::operator==(Type const& _other) const
+bool MappingType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2661,7 +2685,7 @@ string TypeType::identifier() const
 	return "t_type" + identifierList(actualType());
 }
 
-bool TypeType::operator==(Type const& _other) const
+bool TypeType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2750,7 +2774,7 @@ string ModifierType::identifier() const
 	return "t_modifier" + identifierList(m_parameterTypes);
 }
 
-bool ModifierType::operator==(Type const& _other) const
+bool ModifierType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2779,7 +2803,7 @@ string ModuleType::identifier() const
 	return "t_module_" + std::to_string(m_sourceUnit.id());
 }
 
-bool ModuleType::operator==(Type const& _other) const
+bool ModuleType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2816,7 +2840,7 @@ string MagicType::identifier() const
 	return "";
 }
 
-bool MagicType::operator==(Type const& _other) const
+bool MagicType::equals(Type const& _other) const
 {
 	if (_other.category() != category())
 		return false;
@@ -2830,25 +2854,25 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 	{
 	case Kind::Block:
 		return MemberList::MemberMap({
-			{"coinbase", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"timestamp", make_shared<IntegerType>(256)},
+			{"coinbase", TypeProvider::address()},
+			{"timestamp", TypeProvider::uint256()},
 			{"blockhash", make_shared<FunctionType>(strings{"uint"}, strings{"bytes32"}, FunctionType::Kind::BlockHash)},
-			{"difficulty", make_shared<IntegerType>(256)},
-			{"number", make_shared<IntegerType>(256)},
-			{"gaslimit", make_shared<IntegerType>(256)}
+			{"difficulty", TypeProvider::uint256()},
+			{"number", TypeProvider::uint256()},
+			{"gaslimit", TypeProvider::uint256()}
 		});
 	case Kind::Message:
 		return MemberList::MemberMap({
-			{"sender", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"gas", make_shared<IntegerType>(256)},
-			{"value", make_shared<IntegerType>(256)},
+			{"sender", TypeProvider::address()},
+			{"gas", TypeProvider::uint256()},
+			{"value", TypeProvider::uint256()},
 			{"data", make_shared<ArrayType>(DataLocation::CallData)},
-			{"sig", make_shared<FixedBytesType>(4)}
+			{"sig", TypeProvider::fixedBytes(4)}
 		});
 	case Kind::Transaction:
 		return MemberList::MemberMap({
-			{"origin", make_shared<IntegerType>(0, IntegerType::Modifier::Address)},
-			{"gasprice", make_shared<IntegerType>(256)}
+			{"origin", TypeProvider::address()},
+			{"gasprice", TypeProvider::uint256()}
 		});
 	default:
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Unknown kind of magic."));
@@ -2869,3 +2893,8 @@ string MagicType::toString(bool) const
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Unknown kind of magic."));
 	}
 }
+
+TypePointer InaccessibleDynamicType::decodingType() const
+{
+	return TypeProvider::uint256();
+}
@@ -34,6 +34,7 @@
 #include <boost/rational.hpp>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
 
@@ -127,6 +128,8 @@ public:
 
 private:
 	MemberMap m_memberTypes;
+	/// Computed on first use, possibly concurrently by contracts compiled in parallel.
+	mutable std::once_flag m_storageOffsetsComputed;
 	mutable std::unique_ptr<StorageOffsets> m_storageOffsets;
 };
 
@@ -182,8 +185,14 @@ public:
 		return Token::isCompareOp(_operator) ? commonType(shared_from_this(), _other) : TypePointer();
 	}
 
-	virtual bool operator==(Type const& _other) const { return category() == _other.category(); }
-	virtual bool operator!=(Type const& _other) const { return !this->operator ==(_other); }
+	/// Types provided by TypeProvider exist only once, so they are compared by their address.
+	/// All other types are compared by @a equals.
+	bool operator==(Type const& _other) const
+	{
+		return this == &_other || (!(m_interned && _other.m_interned) && equals(_other));
+	}
+	bool operator!=(Type const& _other) const { return !(*this == _other); }
+	virtual bool equals(Type const& _other) const { return category() == _other.category(); }
 
 	/// @returns number of bytes used by this type when encoded for CALL. If it is a dynamic type,
 	/// returns the size of the pointer (usually 32). Returns 0 if the type cannot be encoded
@@ -269,9 +278,14 @@ public:
 	virtual bool canBeUsedExternally(bool _inLibrary) const { return !!interfaceType(_inLibrary); }
 
 private:
+	friend class TypeProvider;
+
 	/// @returns a member list containing all members added to this type by `using for` directives.
 	static MemberList::MemberMap boundFunctions(Type const& _type, ContractDefinition const& _scope);
 
+	/// True for the types created by TypeProvider, which outlive the AST.
+	bool m_interned = false;
+
 protected:
 	/// @returns the members native to this type depending on the given context. This function
 	/// is used (in conjunction with boundFunctions to fill m_members below.
@@ -280,8 +294,14 @@ protected:
 		return MemberList::MemberMap();
 	}
 
-	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
+	/// Members outside of any contract scope, will be lazy-initialized. Code generation requests
+	/// them concurrently for types shared by contracts compiled in parallel.
+	mutable std::once_flag m_unscopedMembersComputed;
+	mutable std::shared_ptr<MemberList const> m_unscopedMembers;
+	/// List of member types (parameterised by the scope ID of the contract), will be
+	/// lazy-initialized. Types can outlive a contract whose analysis is discarded, whose
+	/// address can then be reused.
+	mutable std::map<uint64_t, std::shared_ptr<MemberList const>> m_members;
 };
 
 /**
@@ -296,16 +316,12 @@ public:
 	};
 	virtual Category category() const override { return Category::Integer; }
 
-	explicit IntegerType(int _bits, Modifier _modifier = Modifier::Unsigned);
-
 	virtual std::string identifier() const override;
 	virtual bool isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual TypePointer binaryOperatorResult(Token::Value _operator, TypePointer const& _other) const override;
 
-	virtual bool operator==(Type const& _other) const override;
-
 	virtual unsigned calldataEncodedSize(bool _padded = true) const override { return _padded ? 32 : m_bits / 8; }
 	virtual unsigned storageBytes() const override { return m_bits / 8; }
 	virtual bool isValueType() const override { return true; }
@@ -324,6 +340,9 @@ public:
 	bool isSigned() const { return m_modifier == Modifier::Signed; }
 
 private:
+	friend class TypeProvider;
+	explicit IntegerType(int _bits, Modifier _modifier = Modifier::Unsigned);
+
 	int m_bits;
 	Modifier m_modifier;
 };
@@ -340,16 +359,12 @@ public:
 	};
 	virtual Category category() const override { return Category::FixedPoint; }
 
-	explicit FixedPointType(int _integerBits, int _fractionalBits, Modifier _modifier = Modifier::Unsigned);
-
 	virtual std::string identifier() const override;
 	virtual bool isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual TypePointer binaryOperatorResult(Token::Value _operator, TypePointer const& _other) const override;
 
-	virtual bool operator==(Type const& _other) const override;
-
 	virtual unsigned calldataEncodedSize(bool _padded = true) const override { return _padded ? 32 : (m_integerBits + m_fractionalBits) / 8; }
 	virtual unsigned storageBytes() const override { return (m_integerBits + m_fractionalBits) / 8; }
 	virtual bool isValueType() const override { return true; }
@@ -365,6 +380,9 @@ public:
 	bool isSigned() const { return m_modifier == Modifier::Signed; }
 
 private:
+	friend class TypeProvider;
+	explicit FixedPointType(int _integerBits, int _fractionalBits, Modifier _modifier = Modifier::Unsigned);
+
 	int m_integerBits;
 	int m_fractionalBits;
 	Modifier m_modifier;
@@ -393,7 +411,7 @@ public:
 	virtual TypePointer binaryOperatorResult(Token::Value _operator, TypePointer const& _other) const override;
 
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 
 	virtual bool canBeStored() const override { return false; }
 	virtual bool canLiveOutsideStorage() const override { return false; }
@@ -438,7 +456,7 @@ public:
 	}
 
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 
 	virtual bool canBeStored() const override { return false; }
 	virtual bool canLiveOutsideStorage() const override { return false; }
@@ -465,14 +483,11 @@ public:
 
 	/// @returns the smallest bytes type for the given literal or an empty pointer
 	/// if no type fits.
-	static std::shared_ptr<FixedBytesType> smallestTypeForLiteral(std::string const& _literal);
-
-	explicit FixedBytesType(int _bytes);
+	static std::shared_ptr<FixedBytesType const> smallestTypeForLiteral(std::string const& _literal);
 
 	virtual bool isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual TypePointer binaryOperatorResult(Token::Value _operator, TypePointer const& _other) const override;
 
@@ -488,6 +503,9 @@ public:
 	int numBytes() const { return m_bytes; }
 
 private:
+	friend class TypeProvider;
+	explicit FixedBytesType(int _bytes);
+
 	int m_bytes;
 };
 
@@ -497,7 +515,6 @@ private:
 class BoolType: public Type
 {
 public:
-	BoolType() {}
 	virtual Category category() const override { return Category::Bool; }
 	virtual std::string identifier() const override { return "t_bool"; }
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
@@ -511,6 +528,10 @@ public:
 	virtual u256 literalValue(Literal const* _literal) const override;
 	virtual TypePointer encodingType() const override { return shared_from_this(); }
 	virtual TypePointer interfaceType(bool) const override { return shared_from_this(); }
+
+private:
+	friend class TypeProvider;
+	BoolType() {}
 };
 
 /**
@@ -543,7 +564,8 @@ public:
 	/// non-storage objects to a variable of storage pointer type is not possible.
 	bool isPointer() const { return m_isPointer; }
 
-	bool operator==(ReferenceType const& _other) const
+	/// @returns true if @a _other has the same location and is a pointer iff this is.
+	bool hasSameLocation(ReferenceType const& _other) const
 	{
 		return location() == _other.location() && isPointer() == _other.isPointer();
 	}
@@ -577,12 +599,7 @@ public:
 	virtual Category category() const override { return Category::Array; }
 
 	/// Constructor for a byte array ("bytes") and string.
-	explicit ArrayType(DataLocation _location, bool _isString = false):
-		ReferenceType(_location),
-		m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
-		m_baseType(std::make_shared<FixedBytesType>(1))
-	{
-	}
+	explicit ArrayType(DataLocation _location, bool _isString = false);
 	/// Constructor for a dynamically sized array type ("type[]")
 	ArrayType(DataLocation _location, TypePointer const& _baseType):
 		ReferenceType(_location),
@@ -600,7 +617,7 @@ public:
 	virtual bool isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(const Type& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual unsigned calldataEncodedSize(bool _padded) const override;
 	virtual bool isDynamicallySized() const override { return m_hasDynamicLength; }
 	virtual u256 storageSize() const override;
@@ -650,7 +667,7 @@ public:
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual unsigned calldataEncodedSize(bool _padded ) const override
 	{
 		return encodingType()->calldataEncodedSize(_padded);
@@ -663,10 +680,7 @@ public:
 	virtual std::string canonicalName(bool _addDataLocation) const override;
 
 	virtual MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(160, IntegerType::Modifier::Address);
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -692,6 +706,7 @@ private:
 	/// members.
 	bool m_super = false;
 	/// Type of the constructor, @see constructorType. Lazily initialized.
+	mutable std::once_flag m_constructorTypeComputed;
 	mutable FunctionTypePointer m_constructorType;
 };
 
@@ -706,7 +721,7 @@ public:
 		ReferenceType(_location), m_struct(_struct) {}
 	virtual bool isImplicitlyConvertibleTo(const Type& _convertTo) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual unsigned calldataEncodedSize(bool _padded) const override;
 	u256 memorySize() const;
 	virtual u256 storageSize() const override;
@@ -714,10 +729,7 @@ public:
 	virtual std::string toString(bool _short) const override;
 
 	virtual MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return location() == DataLocation::Storage ? std::make_shared<IntegerType>(256) : TypePointer();
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override;
 
 	TypePointer copyForLocation(DataLocation _location, bool _isPointer) const override;
@@ -750,7 +762,7 @@ public:
 	explicit EnumType(EnumDefinition const& _enum): m_enum(_enum) {}
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual unsigned calldataEncodedSize(bool _padded) const override
 	{
 		return encodingType()->calldataEncodedSize(_padded);
@@ -762,10 +774,7 @@ public:
 	virtual bool isValueType() const override { return true; }
 
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(8 * int(storageBytes()));
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -791,7 +800,7 @@ public:
 	explicit TupleType(std::vector<TypePointer> const& _types = std::vector<TypePointer>()): m_components(_types) {}
 	virtual bool isImplicitlyConvertibleTo(Type const& _other) const override;
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual TypePointer binaryOperatorResult(Token::Value, TypePointer const&) const override { return TypePointer(); }
 	virtual std::string toString(bool) const override;
 	virtual bool canBeStored() const override { return false; }
@@ -930,7 +939,7 @@ public:
 	TypePointer const& selfType() const;
 
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual bool isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	virtual TypePointer unaryOperatorResult(Token::Value _operator) const override;
 	virtual TypePointer binaryOperatorResult(Token::Value, TypePointer const&) const override;
@@ -1035,15 +1044,12 @@ public:
 		m_keyType(_keyType), m_valueType(_valueType) {}
 
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual std::string toString(bool _short) const override;
 	virtual std::string canonicalName(bool _addDataLocation) const override;
 	virtual bool canLiveOutsideStorage() const override { return false; }
 	virtual TypePointer binaryOperatorResult(Token::Value, TypePointer const&) const override { return TypePointer(); }
-	virtual TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(256);
-	}
+	virtual TypePointer encodingType() const override;
 	virtual TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : TypePointer();
@@ -1071,7 +1077,7 @@ public:
 
 	virtual TypePointer binaryOperatorResult(Token::Value, TypePointer const&) const override { return TypePointer(); }
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual bool canBeStored() const override { return false; }
 	virtual u256 storageSize() const override;
 	virtual bool canLiveOutsideStorage() const override { return false; }
@@ -1099,7 +1105,7 @@ public:
 	virtual bool canLiveOutsideStorage() const override { return false; }
 	virtual unsigned sizeOnStack() const override { return 0; }
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual std::string toString(bool _short) const override;
 
 private:
@@ -1120,7 +1126,7 @@ public:
 
 	virtual TypePointer binaryOperatorResult(Token::Value, TypePointer const&) const override { return TypePointer(); }
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual bool canBeStored() const override { return false; }
 	virtual bool canLiveOutsideStorage() const override { return true; }
 	virtual unsigned sizeOnStack() const override { return 0; }
@@ -1150,7 +1156,7 @@ public:
 	}
 
 	virtual std::string identifier() const override;
-	virtual bool operator==(Type const& _other) const override;
+	virtual bool equals(Type const& _other) const override;
 	virtual bool canBeStored() const override { return false; }
 	virtual bool canLiveOutsideStorage() const override { return true; }
 	virtual unsigned sizeOnStack() const override { return 0; }
@@ -1183,7 +1189,7 @@ public:
 	virtual bool isValueType() const override { return true; }
 	virtual unsigned sizeOnStack() const override { return 1; }
 	virtual std::string toString(bool) const override { return "inaccessible dynamic type"; }
-	virtual TypePointer decodingType() const override { return std::make_shared<IntegerType>(256); }
+	virtual TypePointer decodingType() const override;
 };
 
 }
@@ -33,9 +33,11 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(bool _optimize = false, unsigned _runs = 200):
+	/// @param _threadPool threads the optimiser uses for a contract, if given.
+	explicit Compiler(bool _optimize = false, unsigned _runs = 200, ThreadPool* _threadPool = nullptr):
 		m_optimize(_optimize),
 		m_optimizeRuns(_runs),
+		m_threadPool(_threadPool),
 		m_runtimeContext(),
 		m_context(&m_runtimeContext)
 	{ }
@@ -72,6 +74,7 @@ public:
 private:
 	bool const m_optimize;
 	unsigned const m_optimizeRuns;
+	ThreadPool* m_threadPool;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
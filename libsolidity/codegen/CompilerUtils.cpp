@@ -22,6 +22,7 @@
 
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libevmasm/Instruction.h>
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
@@ -111,7 +112,7 @@ void CompilerUtils::loadFromMemoryDynamic(
 
 void CompilerUtils::storeInMemory(unsigned _offset)
 {
-	unsigned numBytes = prepareMemoryStore(IntegerType(256), true);
+	unsigned numBytes = prepareMemoryStore(*TypeProvider::uint256(), true);
 	if (numBytes > 0)
 		m_context << u256(_offset) << Instruction::MSTORE;
 }
@@ -121,7 +122,7 @@ void CompilerUtils::storeInMemoryDynamic(Type const& _type, bool _padToWordBound
 	if (auto ref = dynamic_cast<ReferenceType const*>(&_type))
 	{
 		solAssert(ref->location() == DataLocation::Memory, "");
-		storeInMemoryDynamic(IntegerType(256), _padToWordBoundaries);
+		storeInMemoryDynamic(*TypeProvider::uint256(), _padToWordBoundaries);
 	}
 	else if (auto str = dynamic_cast<StringLiteralType const*>(&_type))
 	{
@@ -251,7 +252,7 @@ void CompilerUtils::encodeToMemory(
 			{
 				auto const& strType = dynamic_cast<StringLiteralType const&>(*_givenTypes[i]);
 				m_context << u256(strType.value().size());
-				storeInMemoryDynamic(IntegerType(256), true);
+				storeInMemoryDynamic(*TypeProvider::uint256(), true);
 				// stack: ... <end_of_mem'>
 				storeInMemoryDynamic(strType, _padToWordBoundaries);
 			}
@@ -266,7 +267,7 @@ void CompilerUtils::encodeToMemory(
 				m_context << dupInstruction(1 + arrayType.sizeOnStack());
 				ArrayUtils(m_context).retrieveLength(arrayType, 1);
 				// stack: ... <end_of_mem> <value...> <end_of_mem'> <length>
-				storeInMemoryDynamic(IntegerType(256), true);
+				storeInMemoryDynamic(*TypeProvider::uint256(), true);
 				// stack: ... <end_of_mem> <value...> <end_of_mem''>
 				// copy the new memory pointer
 				m_context << swapInstruction(arrayType.sizeOnStack() + 1) << Instruction::POP;
@@ -424,7 +425,7 @@ void CompilerUtils::convertType(
 			IntegerType const& targetIntegerType = dynamic_cast<IntegerType const&>(_targetType);
 			m_context << (u256(1) << (256 - typeOnStack.numBytes() * 8)) << Instruction::SWAP1 << Instruction::DIV;
 			if (targetIntegerType.numBits() < typeOnStack.numBytes() * 8)
-				convertType(IntegerType(typeOnStack.numBytes() * 8), _targetType, _cleanupNeeded);
+				convertType(*TypeProvider::integer(typeOnStack.numBytes() * 8), _targetType, _cleanupNeeded);
 		}
 		else
 		{
@@ -504,9 +505,8 @@ void CompilerUtils::convertType(
 		else
 		{
 			solAssert(targetTypeCategory == Type::Category::Integer || targetTypeCategory == Type::Category::Contract, "");
-			IntegerType addressType(0, IntegerType::Modifier::Address);
 			IntegerType const& targetType = targetTypeCategory == Type::Category::Integer
-				? dynamic_cast<IntegerType const&>(_targetType) : addressType;
+				? dynamic_cast<IntegerType const&>(_targetType) : *TypeProvider::address();
 			if (stackTypeCategory == Type::Category::RationalNumber)
 			{
 				RationalNumberType const& constType = dynamic_cast<RationalNumberType const&>(_typeOnStack);
@@ -519,7 +519,7 @@ void CompilerUtils::convertType(
 			else
 			{
 				IntegerType const& typeOnStack = stackTypeCategory == Type::Category::Integer
-					? dynamic_cast<IntegerType const&>(_typeOnStack) : addressType;
+					? dynamic_cast<IntegerType const&>(_typeOnStack) : *TypeProvider::address();
 				// Widening: clean up according to source type width
 				// Non-widening and force: clean up according to target type bits
 				if (targetType.numBits() > typeOnStack.numBits())
@@ -556,7 +556,7 @@ void CompilerUtils::convertType(
 			allocateMemory();
 			// stack: mempos
 			m_context << Instruction::DUP1 << u256(data.size());
-			storeInMemoryDynamic(IntegerType(256));
+			storeInMemoryDynamic(*TypeProvider::uint256());
 			// stack: mempos datapos
 			storeStringData(data);
 			break;
@@ -606,7 +606,7 @@ void CompilerUtils::convertType(
 				if (targetType.isDynamicallySized())
 				{
 					m_context << Instruction::DUP2;
-					storeInMemoryDynamic(IntegerType(256));
+					storeInMemoryDynamic(*TypeProvider::uint256());
 				}
 				// stack: <mem start> <source ref> (variably sized) <length> <mem data pos>
 				if (targetType.baseType()->isValueType())
@@ -845,7 +845,7 @@ void CompilerUtils::pushZeroValue(Type const& _type)
 				{
 					// zero length
 					_context << u256(0);
-					utils.storeInMemoryDynamic(IntegerType(256));
+					utils.storeInMemoryDynamic(*TypeProvider::uint256());
 				}
 				else if (arrayType->length() > 0)
 				{
@@ -950,7 +950,7 @@ void CompilerUtils::storeStringData(bytesConstRef _data)
 		for (unsigned i = 0; i < _data.size(); i += 32)
 		{
 			m_context << h256::Arith(h256(_data.cropped(i), h256::AlignLeft));
-			storeInMemoryDynamic(IntegerType(256));
+			storeInMemoryDynamic(*TypeProvider::uint256());
 		}
 		m_context << Instruction::POP;
 	}
@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libsolidity/inlineasm/AsmCodeGen.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/ErrorReporter.h>
 #include <libsolidity/codegen/ExpressionCompiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
@@ -253,7 +254,7 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 	// retrieve the function signature hash from the calldata
 	if (!interfaceFunctions.empty())
-		CompilerUtils(m_context).loadFromMemory(0, IntegerType(CompilerUtils::dataStartOffset * 8), true);
+		CompilerUtils(m_context).loadFromMemory(0, *TypeProvider::integer(CompilerUtils::dataStartOffset * 8), true);
 
 	// stack now is: 1 0 <funhash>
 	for (auto const& it: interfaceFunctions)
@@ -346,12 +347,12 @@ void ContractCompiler::appendCalldataUnpacker(TypePointers const& _typeParameter
 				if (calldataType->isDynamicallySized())
 				{
 					// put on stack: data_pointer length
-					CompilerUtils(m_context).loadFromMemoryDynamic(IntegerType(256), !_fromMemory);
+					CompilerUtils(m_context).loadFromMemoryDynamic(*TypeProvider::uint256(), !_fromMemory);
 					// stack: base_offset data_offset next_pointer
 					m_context << Instruction::SWAP1 << Instruction::DUP3 << Instruction::ADD;
 					// stack: base_offset next_pointer data_pointer
 					// retrieve length
-					CompilerUtils(m_context).loadFromMemoryDynamic(IntegerType(256), !_fromMemory, true);
+					CompilerUtils(m_context).loadFromMemoryDynamic(*TypeProvider::uint256(), !_fromMemory, true);
 					// stack: base_offset next_pointer length data_pointer
 					m_context << Instruction::SWAP2;
 					// stack: base_offset data_pointer length next_pointer
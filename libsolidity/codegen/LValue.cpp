@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/LValue.h>
 #include <libevmasm/Instruction.h>
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
@@ -419,11 +420,8 @@ void StorageItem::setToZero(SourceLocation const&, bool _removeReference) const
 	}
 }
 
-/// Used in StorageByteArrayElement
-static FixedBytesType byteType(1);
-
 StorageByteArrayElement::StorageByteArrayElement(CompilerContext& _compilerContext):
-	LValue(_compilerContext, &byteType)
+	LValue(_compilerContext, TypeProvider::fixedBytes(1).get())
 {
 }
 
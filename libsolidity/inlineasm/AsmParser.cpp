@@ -212,9 +212,9 @@ assembly::Statement Parser::parseExpression()
 std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::solidity::Instruction> s_instructions;
-	if (s_instructions.empty())
+	static map<string, dev::solidity::Instruction> const s_instructions = []()
 	{
+		map<string, dev::solidity::Instruction> instructions;
 		for (auto const& instruction: solidity::c_instructions)
 		{
 			if (
@@ -224,28 +224,30 @@ std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			instructions[name] = instruction.second;
 		}
 
 		// add alias for suicide
-		s_instructions["suicide"] = solidity::Instruction::SELFDESTRUCT;
+		instructions["suicide"] = solidity::Instruction::SELFDESTRUCT;
 		// add alis for sha3
-		s_instructions["sha3"] = solidity::Instruction::KECCAK256;
-	}
+		instructions["sha3"] = solidity::Instruction::KECCAK256;
+		return instructions;
+	}();
 	return s_instructions;
 }
 
 std::map<dev::solidity::Instruction, string> const& Parser::instructionNames()
 {
-	static map<dev::solidity::Instruction, string> s_instructionNames;
-	if (s_instructionNames.empty())
+	static map<dev::solidity::Instruction, string> const s_instructionNames = []()
 	{
+		map<dev::solidity::Instruction, string> instructionNames;
 		for (auto const& instr: instructions())
-			s_instructionNames[instr.second] = instr.first;
+			instructionNames[instr.second] = instr.first;
 		// set the ambiguous instructions to a clear default
-		s_instructionNames[solidity::Instruction::SELFDESTRUCT] = "selfdestruct";
-		s_instructionNames[solidity::Instruction::KECCAK256] = "keccak256";
-	}
+		instructionNames[solidity::Instruction::SELFDESTRUCT] = "selfdestruct";
+		instructionNames[solidity::Instruction::KECCAK256] = "keccak256";
+		return instructionNames;
+	}();
 	return s_instructionNames;
 }
 
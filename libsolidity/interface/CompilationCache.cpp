@@ -0,0 +1,172 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Persistent on-disk cache for compilation results.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolidity/interface/Version.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/SHA3.h>
+
+#include <boost/filesystem.hpp>
+
+#include <mutex>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+string hashString(string const& _content)
+{
+	return "0x" + toHex(keccak256(_content).asBytes());
+}
+
+}
+
+h256 CompilationCache::key(StringMap const& _sources, Json::Value const& _settings)
+{
+	Json::Value input(Json::objectValue);
+	input["version"] = VersionString;
+	input["settings"] = _settings;
+	input["sources"] = Json::objectValue;
+	for (auto const& source: _sources)
+		input["sources"][source.first] = hashString(source.second);
+	// Object members are serialised in sorted order, so this is canonical.
+	return keccak256(jsonCompactPrint(input));
+}
+
+Json::Value CompilationCache::load(h256 const& _key)
+{
+	Json::Value entry;
+	string contents = contentsString(entryPath(_key));
+	bool hit =
+		!contents.empty() &&
+		Json::Reader().parse(contents, entry, false) &&
+		entry["output"].isObject() &&
+		importsUnchanged(entry);
+	recordLookup(hit);
+	return hit ? entry["output"] : Json::Value();
+}
+
+void CompilationCache::store(h256 const& _key, Json::Value const& _output, StringMap const& _importedSources)
+{
+	Json::Value entry(Json::objectValue);
+	entry["imports"] = Json::objectValue;
+	for (auto const& source: _importedSources)
+		entry["imports"][source.first] = hashString(source.second);
+	entry["output"] = _output;
+	try
+	{
+		writeFile(entryPath(_key), jsonCompactPrint(entry), true);
+	}
+	catch (...)
+	{
+		// Not being able to write to the cache is not an error.
+	}
+}
+
+bytes CompilationCache::loadAST(h256 const& _sourceHash) const
+{
+	return asBytes(contentsString(astPath(_sourceHash)));
+}
+
+void CompilationCache::storeAST(h256 const& _sourceHash, bytes const& _ast) const
+{
+	try
+	{
+		writeFile(astPath(_sourceHash), _ast, true);
+	}
+	catch (...)
+	{
+		// Not being able to write to the cache is not an error.
+	}
+}
+
+CompilationCache::Statistics CompilationCache::statistics() const
+{
+	Statistics statistics;
+	Json::Value stored;
+	string contents = contentsString(statisticsPath());
+	if (!contents.empty() && Json::Reader().parse(contents, stored, false) && stored.isObject())
+	{
+		statistics.hits = stored.get("hits", Json::Value(0)).asUInt64();
+		statistics.misses = stored.get("misses", Json::Value(0)).asUInt64();
+	}
+	return statistics;
+}
+
+string CompilationCache::entryPath(h256 const& _key) const
+{
+	return (boost::filesystem::path(m_directory) / (toHex(_key.asBytes()) + ".json")).string();
+}
+
+string CompilationCache::astPath(h256 const& _sourceHash) const
+{
+	return (boost::filesystem::path(m_directory) / (toHex(_sourceHash.asBytes()) + ".ast")).string();
+}
+
+string CompilationCache::statisticsPath() const
+{
+	return (boost::filesystem::path(m_directory) / "statistics.json").string();
+}
+
+bool CompilationCache::importsUnchanged(Json::Value const& _entry) const
+{
+	Json::Value const& imports = _entry["imports"];
+	if (!imports.isObject())
+		return false;
+	for (auto const& name: imports.getMemberNames())
+	{
+		if (!m_readFile)
+			return false;
+		ReadFile::Result result = m_readFile(name);
+		if (!result.success || hashString(result.contentsOrErrorMessage) != imports[name].asString())
+			return false;
+	}
+	return true;
+}
+
+void CompilationCache::recordLookup(bool _hit)
+{
+	// Several compilations can use the same directory concurrently in the compiler server.
+	static mutex statisticsMutex;
+	lock_guard<mutex> lock(statisticsMutex);
+	Statistics statistics = this->statistics();
+	if (_hit)
+		statistics.hits++;
+	else
+		statistics.misses++;
+	Json::Value stored(Json::objectValue);
+	stored["hits"] = Json::UInt64(statistics.hits);
+	stored["misses"] = Json::UInt64(statistics.misses);
+	try
+	{
+		writeFile(statisticsPath(), jsonCompactPrint(stored), true);
+	}
+	catch (...)
+	{
+		// Not being able to write to the cache is not an error.
+	}
+}
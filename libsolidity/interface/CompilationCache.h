@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Persistent on-disk cache for compilation results.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace dev
+{
+
+namespace solidity
+{
+
+/**
+ * Content-addressed cache of compilation outputs in a directory on disk.
+ * Entries are keyed by the hash of the compiler version, the output-relevant settings
+ * and the contents of all supplied sources. Sources that were only loaded through the
+ * import callback are recorded together with their hash in the entry and have to be
+ * unchanged for the entry to be used.
+ * The cache is best-effort: any problem with the directory results in a cache miss.
+ * Finally, the binary ASTs of individual sources are kept, so that unchanged sources are not
+ * parsed again if the compilation as a whole is not cached.
+ */
+class CompilationCache: boost::noncopyable
+{
+public:
+	struct Statistics
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+	};
+
+	explicit CompilationCache(std::string const& _directory, ReadFile::Callback const& _readFile = ReadFile::Callback()):
+		m_directory(_directory), m_readFile(_readFile) {}
+
+	/// @returns the cache key for the sources @a _sources (name to content) compiled with
+	/// @a _settings, which must only contain settings that influence the output.
+	static h256 key(StringMap const& _sources, Json::Value const& _settings);
+
+	/// Looks up the entry for @a _key and updates the statistics.
+	/// @returns the cached output or a null value on a miss.
+	Json::Value load(h256 const& _key);
+	/// Stores @a _output under @a _key. @a _importedSources are the sources (name to content)
+	/// that were loaded through the import callback during compilation.
+	void store(h256 const& _key, Json::Value const& _output, StringMap const& _importedSources);
+
+	/// @returns the binary AST stored for the source with hash @a _sourceHash or empty bytes.
+	bytes loadAST(h256 const& _sourceHash) const;
+	/// Stores the binary AST @a _ast of the source with hash @a _sourceHash.
+	void storeAST(h256 const& _sourceHash, bytes const& _ast) const;
+
+	/// @returns the number of hits and misses recorded in the cache directory.
+	Statistics statistics() const;
+
+private:
+	std::string entryPath(h256 const& _key) const;
+	std::string astPath(h256 const& _sourceHash) const;
+	std::string statisticsPath() const;
+	/// @returns true if all sources recorded in @a _entry can still be read with the same content.
+	bool importsUnchanged(Json::Value const& _entry) const;
+	void recordLookup(bool _hit);
+
+	std::string m_directory;
+	ReadFile::Callback m_readFile;
+};
+
+}
+}
@@ -0,0 +1,251 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Long-running compiler process that compiles Standard JSON requests on a pool of workers.
+ */
+
+#include <libsolidity/interface/CompilerServer.h>
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libdevcore/Common.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <queue>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+string formatFramingError(string const& _message)
+{
+	Json::Value error = Json::objectValue;
+	error["type"] = "JSONError";
+	error["component"] = "general";
+	error["severity"] = "error";
+	error["message"] = _message;
+	error["formattedMessage"] = _message;
+	Json::Value output = Json::objectValue;
+	output["errors"] = Json::arrayValue;
+	output["errors"].append(error);
+	return jsonCompactPrint(output);
+}
+
+}
+
+CompilerServer::CompilerServer(ReadFile::Callback const& _readFile, unsigned _workers, string const& _cacheDirectory):
+	m_readFile(_readFile),
+	m_cacheDirectory(_cacheDirectory)
+{
+	if (_workers == 0)
+		_workers = max(1u, thread::hardware_concurrency());
+	for (unsigned i = 0; i < _workers; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+CompilerServer::~CompilerServer()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+future<CompilerServer::Result> CompilerServer::submit(string _input)
+{
+	Job job;
+	job.input = move(_input);
+	future<Result> result = job.result.get_future();
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_queue.push_back(move(job));
+	}
+	m_condition.notify_one();
+	return result;
+}
+
+void CompilerServer::work()
+{
+	StandardCompiler compiler(m_readFile);
+	compiler.setCacheDirectory(m_cacheDirectory);
+	while (true)
+	{
+		Job job;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_condition.wait(lock, [&]() { return m_stopping || !m_queue.empty(); });
+			// Jobs that are already queued are still processed, somebody might wait for them.
+			if (m_queue.empty())
+				return;
+			job = move(m_queue.front());
+			m_queue.pop_front();
+		}
+		// StandardCompiler::compile does not throw.
+		Result result;
+		auto start = chrono::steady_clock::now();
+		result.output = compiler.compile(job.input);
+		result.milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		job.result.set_value(move(result));
+	}
+}
+
+size_t const CompilerServer::c_maxMessageLength;
+
+bool CompilerServer::serve(istream& _input, ostream& _output)
+{
+	// All of the following is guarded by the mutex.
+	mutex responsesMutex;
+	condition_variable responsesCondition;
+	queue<future<Result>> responses;
+	bool inputFinished = false;
+
+	thread writer([&]()
+	{
+		while (true)
+		{
+			future<Result> response;
+			{
+				unique_lock<mutex> lock(responsesMutex);
+				responsesCondition.wait(lock, [&]() { return inputFinished || !responses.empty(); });
+				if (responses.empty())
+					return;
+				response = move(responses.front());
+				responses.pop();
+			}
+			writeMessage(_output, response.get().output);
+		}
+	});
+	// Lets the writer finish the queued responses and waits for it, also if reading throws.
+	ScopeGuard joinWriter([&]()
+	{
+		{
+			lock_guard<mutex> lock(responsesMutex);
+			inputFinished = true;
+		}
+		responsesCondition.notify_one();
+		writer.join();
+	});
+
+	string request;
+	string error;
+	while (readMessage(_input, request, error))
+	{
+		lock_guard<mutex> lock(responsesMutex);
+		responses.push(submit(move(request)));
+		responsesCondition.notify_one();
+	}
+
+	if (!error.empty())
+	{
+		promise<Result> errorResponse;
+		Result result;
+		result.output = formatFramingError(error);
+		errorResponse.set_value(move(result));
+		lock_guard<mutex> lock(responsesMutex);
+		responses.push(errorResponse.get_future());
+	}
+	return error.empty();
+}
+
+bool CompilerServer::readMessage(istream& _input, string& _message, string& _error)
+{
+	_message.clear();
+	_error.clear();
+	bool headerStarted = false;
+	bool haveLength = false;
+	size_t length = 0;
+	string line;
+	while (getline(_input, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+		{
+			// Empty lines between messages are ignored, an empty line after a header ends it.
+			if (!headerStarted)
+				continue;
+			break;
+		}
+		headerStarted = true;
+		size_t colon = line.find(':');
+		if (colon == string::npos)
+		{
+			_error = "Invalid message header \"" + line + "\".";
+			return false;
+		}
+		string name = boost::trim_copy(line.substr(0, colon));
+		string value = boost::trim_copy(line.substr(colon + 1));
+		if (boost::iequals(name, "Content-Length"))
+		{
+			try
+			{
+				length = boost::lexical_cast<size_t>(value);
+				haveLength = true;
+			}
+			catch (boost::bad_lexical_cast const&)
+			{
+				_error = "Invalid content length \"" + value + "\".";
+				return false;
+			}
+			if (length > c_maxMessageLength)
+			{
+				_error = "Content length " + value + " exceeds the maximum of " + to_string(c_maxMessageLength) + ".";
+				return false;
+			}
+		}
+	}
+
+	if (!headerStarted)
+		return false;
+	if (!_input)
+	{
+		_error = "Unexpected end of input in message header.";
+		return false;
+	}
+	if (!haveLength)
+	{
+		_error = "Message header without Content-Length.";
+		return false;
+	}
+	_message.resize(length);
+	if (length > 0 && !_input.read(&_message[0], length))
+	{
+		_message.clear();
+		_error = "Unexpected end of input in message body.";
+		return false;
+	}
+	return true;
+}
+
+void CompilerServer::writeMessage(ostream& _output, string const& _message)
+{
+	_output << "Content-Length: " << _message.size() << "\r\n\r\n" << _message;
+	_output.flush();
+}
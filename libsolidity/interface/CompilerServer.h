@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Long-running compiler process that compiles Standard JSON requests on a pool of workers.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+namespace solidity
+{
+
+/**
+ * Compiles Standard JSON inputs on a fixed pool of worker threads. Every worker keeps its own
+ * StandardCompiler for its whole lifetime, so static tables, the per-thread optimizer rules
+ * and the interned types stay initialised between requests.
+ *
+ * In @a serve, requests and responses are framed by a header, as in the language server
+ * protocol:
+ *
+ *   Content-Length: <number of bytes>\r\n
+ *   \r\n
+ *   <Standard JSON>
+ *
+ * Responses are written in the order of the requests.
+ */
+class CompilerServer: boost::noncopyable
+{
+public:
+	/// @param _readFile callback to read imported files, it is called concurrently from all workers.
+	/// @param _workers number of worker threads, zero uses one per CPU core.
+	/// @param _cacheDirectory directory of the persistent compilation cache, if any.
+	CompilerServer(
+		ReadFile::Callback const& _readFile = ReadFile::Callback(),
+		unsigned _workers = 0,
+		std::string const& _cacheDirectory = ""
+	);
+	~CompilerServer();
+
+	struct Result
+	{
+		/// Serialized Standard JSON output.
+		std::string output;
+		/// Time spent compiling the input, not including the time it waited in the queue.
+		double milliseconds = 0;
+	};
+
+	/// Queues the Standard JSON @a _input for compilation.
+	std::future<Result> submit(std::string _input);
+
+	/// Reads framed requests from @a _input until its end and writes the framed responses to
+	/// @a _output.
+	/// @returns false if the input was not properly framed. An error response is sent for the
+	/// malformed request and the remaining input is ignored.
+	bool serve(std::istream& _input, std::ostream& _output);
+
+	/// Messages with a larger Content-Length are rejected as invalid framing.
+	static size_t const c_maxMessageLength = 128 * 1024 * 1024;
+
+	/// Reads a framed message from @a _input into @a _message.
+	/// @returns false at the end of the input or if the framing is invalid, in which case
+	/// @a _error is set.
+	static bool readMessage(std::istream& _input, std::string& _message, std::string& _error);
+	static void writeMessage(std::ostream& _output, std::string const& _message);
+
+private:
+	struct Job
+	{
+		std::string input;
+		std::promise<Result> result;
+	};
+
+	void work();
+
+	ReadFile::Callback m_readFile;
+	std::string m_cacheDirectory;
+
+	/// Guards the queue and the stop flag.
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<Job> m_queue;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+}
+}
@@ -27,6 +27,8 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/analysis/SemVerHandler.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
 #include <libsolidity/parsing/Scanner.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/analysis/GlobalContext.h>
@@ -51,6 +53,10 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 using namespace std;
 using namespace dev;
@@ -89,18 +95,32 @@ void CompilerStack::reset(bool _keepSources)
 	}
 	m_optimize = false;
 	m_optimizeRuns = 200;
+	m_contractsToCompile.clear();
 	m_globalContext.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	m_analysisReusable = false;
+	m_sourcesToAnalyze.clear();
 }
 
-bool CompilerStack::addSource(string const& _name, string const& _content, bool _isLibrary)
+bool CompilerStack::addSource(string const& _name, string _content, bool _isLibrary)
 {
 	bool existed = m_sources.count(_name) != 0;
-	reset(true);
-	m_sources[_name].scanner = make_shared<Scanner>(CharStream(_content), _name);
+	if (m_incrementalAnalysis && m_analysisReusable)
+	{
+		// The contracts refer to the ASTs, they are collected again during analysis.
+		m_contracts.clear();
+		m_stackState = SourcesSet;
+		Source const* source = existed ? &m_sources[_name] : nullptr;
+		if (source && source->scanner->source() == _content && source->isLibrary == _isLibrary)
+			return true;
+		m_sourcesToAnalyze.insert(_name);
+	}
+	else
+		reset(true);
+	m_sources[_name].scanner = make_shared<Scanner>(CharStream(move(_content)), _name);
 	m_sources[_name].isLibrary = _isLibrary;
 	m_stackState = SourcesSet;
 	return existed;
@@ -117,35 +137,49 @@ bool CompilerStack::parse()
 	//reset
 	if(m_stackState != SourcesSet)
 		return false;
-	m_errorReporter.clear();
-	ASTNode::resetID();
+	if (m_incrementalAnalysis && m_analysisReusable)
+	{
+		m_sourcesToAnalyze = sourcesAndImporters(m_sourcesToAnalyze);
+		for (string const& name: m_sourcesToAnalyze)
+			discardAnalysis(name);
+		// Keep the warnings about the sources whose analysis is reused.
+		ErrorList retainedErrors;
+		for (auto const& error: m_errorReporter.errors())
+		{
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+			if (location && location->sourceName && !m_sourcesToAnalyze.count(*location->sourceName))
+				retainedErrors.push_back(error);
+		}
+		m_errorList = move(retainedErrors);
+	}
+	else
+	{
+		m_errorReporter.clear();
+		ASTNode::resetID();
+		m_sourcesToAnalyze.clear();
+		for (auto const& s: m_sources)
+			m_sourcesToAnalyze.insert(s.first);
+	}
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning("This is a pre-release compiler version, please do not use it in production.");
 
-	vector<string> sourcesToParse;
-	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
-	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = Parser(m_errorReporter).parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+	vector<string> sourcesToParse(m_sourcesToAnalyze.begin(), m_sourcesToAnalyze.end());
+	unsigned threads = parallelism();
+	if (threads > 1)
+		parseSourcesInParallel(sourcesToParse, threads);
+	else
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
-			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents), newPath);
-				sourcesToParse.push_back(newPath);
-			}
+			string const& path = sourcesToParse[i];
+			Source& source = m_sources[path];
+			source.arena = make_shared<ASTArena>();
+			parseSource(source, m_errorReporter);
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+				addImportedSources(path, sourcesToParse);
 		}
-	}
 	if (Error::containsOnlyWarnings(m_errorReporter.errors()))
 	{
 		m_stackState = ParsingSuccessful;
@@ -161,31 +195,38 @@ bool CompilerStack::analyze()
 		return false;
 	resolveImports();
 
+	vector<Source const*> sourcesToAnalyze;
+	for (Source const* source: m_sourceOrder)
+		if (m_sourcesToAnalyze.count(source->ast->annotation().path))
+			sourcesToAnalyze.push_back(source);
+
 	bool noErrors = true;
 	SyntaxChecker syntaxChecker(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		if (!syntaxChecker.checkSyntax(*source->ast))
 			noErrors = false;
 
 	DocStringAnalyser docStringAnalyser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		if (!docStringAnalyser.analyseDocStrings(*source->ast))
 			noErrors = false;
 
-	m_globalContext = make_shared<GlobalContext>();
+	// The global context is kept if analysis results are reused, because they refer to its objects.
+	if (!m_globalContext)
+		m_globalContext = make_shared<GlobalContext>();
 	NameAndTypeResolver resolver(m_globalContext->declarations(), m_scopes, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		if (!resolver.registerDeclarations(*source->ast))
 			return false;
 
 	map<string, SourceUnit const*> sourceUnitsByName;
 	for (auto& source: m_sources)
 		sourceUnitsByName[source.first] = source.second.ast.get();
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		if (!resolver.performImports(*source->ast, sourceUnitsByName))
 			return false;
 
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 			{
@@ -193,17 +234,9 @@ bool CompilerStack::analyze()
 				if (!resolver.updateDeclaration(*m_globalContext->currentThis())) return false;
 				if (!resolver.updateDeclaration(*m_globalContext->currentSuper())) return false;
 				if (!resolver.resolveNamesAndTypes(*contract)) return false;
-
-				// Note that we now reference contracts by their fully qualified names, and
-				// thus contracts can only conflict if declared in the same source file.  This
-				// already causes a double-declaration error elsewhere, so we do not report
-				// an error here and instead silently drop any additional contracts we find.
-
-				if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-					m_contracts[contract->fullyQualifiedName()].contract = contract;
 			}
 
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: sourcesToAnalyze)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 			{
@@ -217,20 +250,22 @@ bool CompilerStack::analyze()
 				}
 				else
 					noErrors = false;
+			}
 
-				// Note that we now reference contracts by their fully qualified names, and
-				// thus contracts can only conflict if declared in the same source file.  This
-				// already causes a double-declaration error elsewhere, so we do not report
-				// an error here and instead silently drop any additional contracts we find.
-
+	// Note that we now reference contracts by their fully qualified names, and
+	// thus contracts can only conflict if declared in the same source file.  This
+	// already causes a double-declaration error elsewhere, so we do not report
+	// an error here and instead silently drop any additional contracts we find.
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 				if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
 					m_contracts[contract->fullyQualifiedName()].contract = contract;
-			}
 
 	if (noErrors)
 	{
 		PostTypeChecker postTypeChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (!postTypeChecker.check(*source->ast))
 				noErrors = false;
 	}
@@ -238,7 +273,7 @@ bool CompilerStack::analyze()
 	if (noErrors)
 	{
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyze)
 			if (!staticAnalyzer.analyze(*source->ast))
 				noErrors = false;
 	}
@@ -246,6 +281,8 @@ bool CompilerStack::analyze()
 	if (noErrors)
 	{
 		m_stackState = AnalysisSuccessful;
+		m_analysisReusable = true;
+		m_sourcesToAnalyze.clear();
 		return true;
 	}
 	else
@@ -290,11 +327,16 @@ bool CompilerStack::compile(bool _optimize, unsigned _runs, map<string, h160> co
 	m_optimizeRuns = _runs;
 	m_libraries = _libraries;
 
-	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				compileContract(*contract, compiledContracts);
+	vector<ContractDefinition const*> contracts = contractsInDependencyOrder();
+	ThreadPool* pool = threadPool();
+	if (pool && contracts.size() > 1)
+		compileContractsInParallel(contracts, *pool);
+	else
+	{
+		map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
+		for (auto const* contract: contracts)
+			compiledContracts[contract] = &compileContract(*contract, compiledContracts);
+	}
 	this->link();
 	m_stackState = CompilationSuccessful;
 	return true;
@@ -311,7 +353,6 @@ void CompilerStack::link()
 	{
 		contract.second.object.link(m_libraries);
 		contract.second.runtimeObject.link(m_libraries);
-		contract.second.cloneObject.link(m_libraries);
 	}
 }
 
@@ -382,7 +423,12 @@ eth::LinkerObject const& CompilerStack::runtimeObject(string const& _contractNam
 
 eth::LinkerObject const& CompilerStack::cloneObject(string const& _contractName) const
 {
-	return contract(_contractName).cloneObject;
+	Contract const& c = contract(_contractName);
+	if (!c.cloneObject)
+		c.cloneObject.reset(new eth::LinkerObject(
+			c.compiler ? compileClone(*c.contract) : eth::LinkerObject()
+		));
+	return *c.cloneObject;
 }
 
 Json::Value CompilerStack::streamAssembly(ostream& _outStream, string const& _contractName, StringMap _sourceCodes, bool _inJsonFormat) const
@@ -536,6 +582,50 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 	return make_tuple(++startLine, ++startColumn, ++endLine, ++endColumn);
 }
 
+set<string> CompilerStack::sourcesAndImporters(set<string> const& _sources) const
+{
+	map<string, set<string>> importers;
+	for (auto const& source: m_sources)
+		if (source.second.ast)
+			for (ASTPointer<ASTNode> const& node: source.second.ast->nodes())
+				if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
+					importers[import->annotation().absolutePath].insert(source.first);
+
+	set<string> result;
+	vector<string> worklist(_sources.begin(), _sources.end());
+	while (!worklist.empty())
+	{
+		string name = move(worklist.back());
+		worklist.pop_back();
+		if (!result.insert(name).second)
+			continue;
+		for (string const& importer: importers[name])
+			worklist.push_back(importer);
+	}
+	return result;
+}
+
+void CompilerStack::discardAnalysis(string const& _name)
+{
+	Source& source = m_sources.at(_name);
+	if (!source.ast)
+		return;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node)
+		{
+			m_scopes.erase(&_node);
+			if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+				if (m_globalContext)
+					m_globalContext->removeContract(*contract);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	source.ast->accept(visitor);
+	source.ast.reset();
+	source.arena.reset();
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	StringMap newSources;
@@ -569,6 +659,20 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 	return newSources;
 }
 
+void CompilerStack::addImportedSources(string const& _path, vector<string>& _sourcesToParse)
+{
+	SourceUnit& ast = *m_sources[_path].ast;
+	ast.annotation().path = _path;
+	for (auto const& newSource: loadMissingSources(ast, _path))
+	{
+		string const& newPath = newSource.first;
+		string const& newContents = newSource.second;
+		m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents), newPath);
+		_sourcesToParse.push_back(newPath);
+		m_sourcesToAnalyze.insert(newPath);
+	}
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	// Try to find the longest prefix match in all remappings that are active in the current context.
@@ -657,21 +761,298 @@ string CompilerStack::absolutePath(string const& _path, string const& _reference
 	return result.generic_string();
 }
 
-void CompilerStack::compileContract(
+vector<ContractDefinition const*> CompilerStack::contractsInDependencyOrder() const
+{
+	vector<ContractDefinition const*> contracts;
+	set<ContractDefinition const*> visited;
+
+	function<void(ContractDefinition const&)> visit = [&](ContractDefinition const& _contract)
+	{
+		if (
+			visited.count(&_contract) ||
+			!_contract.annotation().isFullyImplemented ||
+			!_contract.constructorIsPublic()
+		)
+			return;
+		visited.insert(&_contract);
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			visit(*dependency);
+		contracts.push_back(&_contract);
+	};
+
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (m_contractsToCompile.empty() || m_contractsToCompile.count(contract->fullyQualifiedName()))
+					visit(*contract);
+	return contracts;
+}
+
+namespace
+{
+
+/// Creates all annotations and cached interface lists of the AST nodes in @a _sourceUnit,
+/// which are otherwise created lazily on first access. Afterwards, code generation only
+/// reads from the AST and can safely run on multiple threads.
+void initializeLazyAnnotations(SourceUnit const& _sourceUnit)
+{
+	SimpleASTVisitor visitor(
+		[](ASTNode const& _node)
+		{
+			_node.annotation();
+			if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+			{
+				contract->interfaceFunctionList();
+				contract->interfaceEvents();
+				contract->inheritableMembers();
+			}
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	_sourceUnit.accept(visitor);
+}
+
+}
+
+void CompilerStack::parseSource(Source& _source, ErrorReporter& _errorReporter)
+{
+	_source.scanner->reset();
+	h256 hash;
+	if (m_loadAST || m_storeAST)
+		hash = keccak256(_source.scanner->source());
+	if (m_loadAST)
+	{
+		bytes binary = m_loadAST(hash);
+		if (!binary.empty())
+		{
+			_source.ast = ASTBinaryConverter::fromBinary(&binary, *_source.scanner, _source.arena);
+			if (_source.ast)
+				return;
+		}
+	}
+
+	size_t firstID = ASTNode::lastID() + 1;
+	size_t errorCount = _errorReporter.errors().size();
+	_source.ast = Parser(_errorReporter, _source.arena).parse(_source.scanner);
+	// Loading the AST would skip the warnings of the parser.
+	if (m_storeAST && _source.ast && _errorReporter.errors().size() == errorCount)
+		m_storeAST(hash, ASTBinaryConverter::toBinary(*_source.ast, ASTNode::lastID() + 1 - firstID));
+}
+
+unsigned CompilerStack::parallelism() const
+{
+	return m_parallelism > 0 ? m_parallelism : max(1u, thread::hardware_concurrency());
+}
+
+ThreadPool* CompilerStack::threadPool()
+{
+	unsigned threads = parallelism();
+	if (threads <= 1)
+		m_threadPool.reset();
+	else if (!m_threadPool || m_threadPool->threads() != threads)
+		m_threadPool.reset(new ThreadPool(threads));
+	return m_threadPool.get();
+}
+
+void CompilerStack::parseSourcesInParallel(vector<string>& _sourcesToParse, unsigned _threads)
+{
+	struct Job
+	{
+		Source* source;
+		ErrorList errors;
+		exception_ptr failure;
+		size_t nodeCount;
+		bool done;
+	};
+
+	// All of the following is guarded by the mutex. Workers only read the job list and write
+	// the results of their jobs, the sources themselves are only modified by the calling thread.
+	std::mutex stateMutex;
+	condition_variable condition;
+	vector<Job> jobs;
+	size_t nextJob = 0;
+	bool finished = false;
+	auto addJob = [&](string const& _path)
+	{
+		jobs.push_back(Job{&m_sources[_path], ErrorList(), nullptr, 0, false});
+	};
+	for (string const& path: _sourcesToParse)
+		addJob(path);
+
+	auto worker = [&]()
+	{
+		unique_lock<std::mutex> lock(stateMutex);
+		while (true)
+		{
+			condition.wait(lock, [&]() { return finished || nextJob < jobs.size(); });
+			if (nextJob == jobs.size())
+				break;
+			size_t index = nextJob++;
+			Source& source = *jobs[index].source;
+			lock.unlock();
+
+			// Every source is numbered starting at one, the IDs are shifted once the
+			// number of nodes in the preceding sources is known.
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			exception_ptr failure;
+			ASTNode::resetID();
+			try
+			{
+				source.arena = make_shared<ASTArena>();
+				source.arena->recordNodes();
+				parseSource(source, errorReporter);
+			}
+			catch (...)
+			{
+				failure = current_exception();
+			}
+
+			lock.lock();
+			jobs[index].errors = move(errors);
+			jobs[index].failure = failure;
+			jobs[index].nodeCount = ASTNode::lastID();
+			jobs[index].done = true;
+			condition.notify_all();
+		}
+	};
+
+	vector<thread> workers;
+	auto startWorkers = [&]()
+	{
+		while (workers.size() < min<size_t>(_threads, jobs.size()))
+			workers.emplace_back(worker);
+	};
+
+	// The results are merged in the order of the jobs, so that the errors, the discovered
+	// imports and the node IDs are the same as in sequential parsing.
+	size_t lastID = ASTNode::lastID();
+	exception_ptr failure;
+	unique_lock<std::mutex> lock(stateMutex);
+	startWorkers();
+	for (size_t index = 0; index < jobs.size() && !failure; ++index)
+	{
+		condition.wait(lock, [&]() { return jobs[index].done; });
+		Job job = move(jobs[index]);
+		lock.unlock();
+
+		// Merging can throw (e.g. from the import callback) while the workers are still
+		// running, so it is handled like a failure of the job and the workers are stopped below.
+		try
+		{
+			m_errorList += job.errors;
+			failure = job.failure;
+			if (job.source->arena)
+				job.source->arena->shiftIDs(lastID);
+			lastID += job.nodeCount;
+			if (!failure && !job.source->ast)
+				solAssert(!Error::containsOnlyWarnings(job.errors), "Parser returned null but did not report error.");
+			else if (!failure)
+			{
+				size_t sourceCount = _sourcesToParse.size();
+				addImportedSources(_sourcesToParse[index], _sourcesToParse);
+				lock.lock();
+				for (size_t i = sourceCount; i < _sourcesToParse.size(); ++i)
+					addJob(_sourcesToParse[i]);
+				startWorkers();
+				condition.notify_all();
+				lock.unlock();
+			}
+		}
+		catch (...)
+		{
+			failure = current_exception();
+		}
+		if (!lock.owns_lock())
+			lock.lock();
+	}
+	finished = true;
+	// Jobs that are not started anymore after a failure.
+	nextJob = jobs.size();
+	condition.notify_all();
+	lock.unlock();
+	for (auto& workerThread: workers)
+		workerThread.join();
+
+	ASTNode::resetID(lastID);
+	if (failure)
+		rethrow_exception(failure);
+}
+
+void CompilerStack::compileContractsInParallel(vector<ContractDefinition const*> const& _contracts, ThreadPool& _threadPool)
+{
+	for (auto const& source: m_sources)
+		if (source.second.ast)
+			initializeLazyAnnotations(*source.second.ast);
+
+	map<ContractDefinition const*, size_t> indices;
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		indices[_contracts[i]] = i;
+	vector<size_t> pendingDependencies(_contracts.size(), 0);
+	vector<vector<size_t>> dependents(_contracts.size());
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		for (auto const* dependency: _contracts[i]->annotation().contractDependencies)
+			if (indices.count(dependency))
+			{
+				pendingDependencies[i]++;
+				dependents[indices[dependency]].push_back(i);
+			}
+
+	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
+	// After a failure, only the contracts before the first failing one are compiled, so that
+	// the reported error is the same as in sequential compilation.
+	size_t firstFailure = _contracts.size();
+	vector<exception_ptr> failures(_contracts.size());
+	vector<size_t> ready;
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		if (pendingDependencies[i] == 0)
+			ready.push_back(i);
+
+	// The contracts of a round and their optimisation share the threads of the pool, so
+	// threads that finish their contract early help with the optimisation of the others.
+	while (!ready.empty())
+	{
+		vector<eth::Assembly const*> assemblies(ready.size(), nullptr);
+		_threadPool.parallelFor(ready.size(), [&](size_t _index)
+		{
+			try
+			{
+				assemblies[_index] = &compileContract(*_contracts[ready[_index]], compiledContracts);
+			}
+			catch (...)
+			{
+				failures[ready[_index]] = current_exception();
+			}
+		});
+
+		vector<size_t> next;
+		for (size_t i = 0; i < ready.size(); ++i)
+			if (failures[ready[i]])
+				firstFailure = min(firstFailure, ready[i]);
+			else
+			{
+				compiledContracts[_contracts[ready[i]]] = assemblies[i];
+				for (size_t dependent: dependents[ready[i]])
+					if (--pendingDependencies[dependent] == 0)
+						next.push_back(dependent);
+			}
+		ready.clear();
+		for (size_t index: next)
+			if (index < firstFailure)
+				ready.push_back(index);
+	}
+
+	if (firstFailure < _contracts.size())
+		rethrow_exception(failures[firstFailure]);
+}
+
+eth::Assembly const& CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+	map<ContractDefinition const*, eth::Assembly const*> const& _compiledContracts
 )
 {
-	if (
-		_compiledContracts.count(&_contract) ||
-		!_contract.annotation().isFullyImplemented ||
-		!_contract.constructorIsPublic()
-	)
-		return;
-	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _compiledContracts);
-
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_optimize, m_optimizeRuns);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_optimize, m_optimizeRuns, m_threadPool.get());
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	string onChainMetadata;
@@ -717,13 +1098,28 @@ void CompilerStack::compileContract(
 	}
 
 	compiledContract.onChainMetadata = onChainMetadata;
-	_compiledContracts[compiledContract.contract] = &compiler->assembly();
+	// The clone is only compiled on request.
+	compiledContract.cloneObject.reset();
+
+	return compiler->assembly();
+}
 
+eth::LinkerObject CompilerStack::compileClone(ContractDefinition const& _contract) const
+{
+	// The assemblies of all contracts are available after compilation and
+	// are not optimised again when used as sub-assemblies of the clone.
+	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
+	for (auto const& contract: m_contracts)
+		if (contract.second.compiler)
+			compiledContracts[contract.second.contract] = &contract.second.compiler->assembly();
+
+	eth::LinkerObject cloneObject;
 	try
 	{
-		Compiler cloneCompiler(m_optimize, m_optimizeRuns);
-		cloneCompiler.compileClone(_contract, _compiledContracts);
-		compiledContract.cloneObject = cloneCompiler.assembledObject();
+		Compiler cloneCompiler(m_optimize, m_optimizeRuns, m_threadPool.get());
+		cloneCompiler.compileClone(_contract, compiledContracts);
+		cloneObject = cloneCompiler.assembledObject();
+		cloneObject.link(m_libraries);
 	}
 	catch (eth::AssemblyException const&)
 	{
@@ -732,6 +1128,7 @@ void CompilerStack::compileContract(
 
 		// TODO: Report error / warning
 	}
+	return cloneObject;
 }
 
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
@@ -827,6 +1224,8 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 {
 	string ret;
 	map<string, unsigned> sourceIndicesMap = sourceIndices();
+	// Source indices by the number of the source name in the items.
+	map<unsigned, int> sourceIndexByID;
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
@@ -836,12 +1235,16 @@ string CompilerStack::computeSourceMapping(eth::AssemblyItems const& _items) con
 		if (!ret.empty())
 			ret += ";";
 
-		SourceLocation const& location = item.location();
+		eth::ItemLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.sourceName && sourceIndicesMap.count(*location.sourceName) ?
-			sourceIndicesMap.at(*location.sourceName) :
-			-1;
+		auto index = sourceIndexByID.find(location.sourceID);
+		if (index == sourceIndexByID.end())
+		{
+			shared_ptr<string const> name = item.sourceLocation().sourceName;
+			int nameIndex = name && sourceIndicesMap.count(*name) ? int(sourceIndicesMap.at(*name)) : -1;
+			index = sourceIndexByID.insert(make_pair(location.sourceID, nameIndex)).first;
+		}
+		int sourceIndex = index->second;
 		char jump = '-';
 		if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -26,6 +26,7 @@
 #include <ostream>
 #include <string>
 #include <memory>
+#include <set>
 #include <vector>
 #include <functional>
 #include <boost/noncopyable.hpp>
@@ -33,6 +34,7 @@
 #include <json/json.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/ThreadPool.h>
 #include <libevmasm/SourceLocation.h>
 #include <libevmasm/LinkerObject.h>
 #include <libsolidity/interface/ErrorReporter.h>
@@ -53,6 +55,7 @@ namespace solidity
 
 // forward declarations
 class Scanner;
+class ASTArena;
 class ASTNode;
 class ContractDefinition;
 class FunctionDefinition;
@@ -88,6 +91,36 @@ public:
 	/// Sets path remappings in the format "context:prefix=target"
 	void setRemappings(std::vector<std::string> const& _remappings);
 
+	/// Sets the maximum number of threads used to parse the sources concurrently, to generate
+	/// code for independent contracts concurrently and to optimise independent blocks of a
+	/// contract concurrently. Zero selects the number of hardware threads, one (the default)
+	/// parses, compiles and optimises sequentially.
+	/// The output does not depend on this setting.
+	void setParallelism(unsigned _threads) { m_parallelism = _threads; }
+
+	/// Enables the reuse of analysis results: After a successful analysis, only the sources that
+	/// are added or changed afterwards and the sources importing them (directly or indirectly)
+	/// are parsed and analysed again. Note that AST node IDs are not reset in this case.
+	void setIncrementalAnalysis(bool _incremental) { m_incrementalAnalysis = _incremental; }
+
+	/// Sets a store for the binary ASTs (see ASTBinaryConverter) of sources, keyed by the hash
+	/// of their contents. Sources whose AST can be loaded are not parsed, the ASTs of the other
+	/// sources are stored if they parse without errors or warnings. @a _load returns empty bytes
+	/// if nothing is stored. Both functions can be called concurrently during parsing.
+	void setASTCache(
+		std::function<bytes(h256 const&)> const& _load,
+		std::function<void(h256 const&, bytes const&)> const& _store
+	)
+	{
+		m_loadAST = _load;
+		m_storeAST = _store;
+	}
+
+	/// Restricts code generation to the contracts with the given fully qualified names and
+	/// the contracts they depend on. An empty set (the default) selects all contracts.
+	/// The selection is cleared by @a reset.
+	void setContractsToCompile(std::set<std::string> const& _contractNames) { m_contractsToCompile = _contractNames; }
+
 	/// Resets the compiler to a state where the sources are not parsed or even removed.
 	void reset(bool _keepSources = false);
 
@@ -97,7 +130,8 @@ public:
 	{
 		for (auto const& i: _nameContents) addSource(i.first, i.second, _isLibrary);
 	}
-	bool addSource(std::string const& _name, std::string const& _content, bool _isLibrary = false);
+	/// The content is moved into a buffer that is shared with the scanner and all source locations.
+	bool addSource(std::string const& _name, std::string _content, bool _isLibrary = false);
 	void setSource(std::string const& _sourceCode);
 	/// Parses all source units that were added
 	/// @returns false on error.
@@ -137,6 +171,7 @@ public:
 	/// The returned bytes will contain a sequence of 20 bytes of the format "XXX...XXX" which have to
 	/// substituted by the actual address. Note that this sequence starts end ends in three X
 	/// characters but can contain anything in between.
+	/// The clone is only compiled on the first request.
 	eth::LinkerObject const& cloneObject(std::string const& _contractName = "") const;
 	/// @returns normal contract assembly items
 	eth::AssemblyItems const* assemblyItems(std::string const& _contractName = "") const;
@@ -203,8 +238,10 @@ private:
 	{
 		std::shared_ptr<Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// Holds the nodes of @a ast, freed once the last node is gone.
+		std::shared_ptr<ASTArena> arena;
 		bool isLibrary = false;
-		void reset() { scanner.reset(); ast.reset(); }
+		void reset() { scanner.reset(); ast.reset(); arena.reset(); }
 	};
 
 	struct Contract
@@ -213,7 +250,7 @@ private:
 		std::shared_ptr<Compiler> compiler;
 		eth::LinkerObject object;
 		eth::LinkerObject runtimeObject;
-		eth::LinkerObject cloneObject;
+		mutable std::unique_ptr<eth::LinkerObject const> cloneObject;
 		std::string onChainMetadata; ///< The metadata json that will be hashed into the chain.
 		mutable std::unique_ptr<Json::Value const> abi;
 		mutable std::unique_ptr<Json::Value const> userDocumentation;
@@ -229,10 +266,19 @@ private:
 		CompilationSuccessful
 	};
 
+	/// @returns the names of @a _sources and of all sources that import one of them, directly
+	/// or indirectly.
+	std::set<std::string> sourcesAndImporters(std::set<std::string> const& _sources) const;
+	/// Removes the AST of the source @a _name together with its scopes and global objects.
+	void discardAnalysis(std::string const& _name);
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// Sets the path annotation of the parsed source @a _path, loads the sources it imports
+	/// that are not present yet and appends them to @a _sourcesToParse.
+	void addImportedSources(std::string const& _path, std::vector<std::string>& _sourcesToParse);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 	/// @returns the absolute path corresponding to @a _path relative to @a _reference.
@@ -240,11 +286,31 @@ private:
 	/// Helper function to return path converted strings.
 	std::string sanitizePath(std::string const& _path) const { return boost::filesystem::path(_path).generic_string(); }
 
-	/// Compile a single contract and put the result in @a _compiledContracts.
-	void compileContract(
+	/// Resets the scanner of @a _source and parses it into its arena, which has to be set already,
+	/// unless its AST can be loaded from the AST cache.
+	void parseSource(Source& _source, ErrorReporter& _errorReporter);
+	/// @returns the number of threads selected by setParallelism.
+	unsigned parallelism() const;
+	/// @returns the threads selected by setParallelism, which are shared by all contracts and
+	/// their optimisation, or null if the selection is a single thread.
+	ThreadPool* threadPool();
+	/// Parses @a _sourcesToParse and the sources they import on up to @a _threads threads.
+	/// Errors, imported sources and node IDs are merged in the order of the sources.
+	void parseSourcesInParallel(std::vector<std::string>& _sourcesToParse, unsigned _threads);
+	/// @returns the contracts to compile (the selected ones and their dependencies) in an order
+	/// such that every contract comes after the contracts it creates.
+	std::vector<ContractDefinition const*> contractsInDependencyOrder() const;
+	/// Compiles @a _contracts (ordered as returned by contractsInDependencyOrder) on the threads
+	/// of @a _threadPool, in rounds of the contracts whose dependencies are compiled.
+	void compileContractsInParallel(std::vector<ContractDefinition const*> const& _contracts, ThreadPool& _threadPool);
+	/// Compile a single contract, whose dependencies have to be present in @a _compiledContracts.
+	/// @returns the creation assembly of the contract.
+	eth::Assembly const& compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+		std::map<ContractDefinition const*, eth::Assembly const*> const& _compiledContracts
 	);
+	/// Compiles and links the clone of the already compiled contract @a _contract.
+	eth::LinkerObject compileClone(ContractDefinition const& _contract) const;
 	void link();
 
 	Contract const& contract(std::string const& _contractName = "") const;
@@ -289,6 +355,16 @@ private:
 	ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
 	bool m_disableOnChainMetadata = false;
+	unsigned m_parallelism = 1;
+	std::unique_ptr<ThreadPool> m_threadPool;
+	std::function<bytes(h256 const&)> m_loadAST;
+	std::function<void(h256 const&, bytes const&)> m_storeAST;
+	bool m_incrementalAnalysis = false;
+	/// True if the analysis of all sources not in m_sourcesToAnalyze can be reused.
+	bool m_analysisReusable = false;
+	/// Names of the sources that have to be parsed and analysed (again).
+	std::set<std::string> m_sourcesToAnalyze;
+	std::set<std::string> m_contractsToCompile;
 	State m_stackState = Empty;
 };
 
@@ -21,12 +21,16 @@
  */
 
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/SourceReferenceFormatter.h>
+#include <libsolidity/parsing/Scanner.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libevmasm/Instruction.h>
 #include <libdevcore/JSON.h>
 #include <libdevcore/SHA3.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
@@ -142,16 +146,84 @@ Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkRefere
 	return ret;
 }
 
-Json::Value collectEVMObject(eth::LinkerObject const& _object, string const* _sourceMap)
+Json::Value collectEVMObject(
+	eth::LinkerObject const& _object,
+	function<string const*()> const& _sourceMap,
+	function<bool(string const&)> const& _isRequested
+)
 {
 	Json::Value output = Json::objectValue;
-	output["object"] = _object.toHex();
-	output["opcodes"] = solidity::disassemble(_object.bytecode);
-	output["sourceMap"] = _sourceMap ? *_sourceMap : "";
-	output["linkReferences"] = formatLinkReferences(_object.linkReferences);
+	if (_isRequested("object"))
+		output["object"] = _object.toHex();
+	if (_isRequested("opcodes"))
+		output["opcodes"] = solidity::disassemble(_object.bytecode);
+	if (_isRequested("sourceMap"))
+	{
+		string const* sourceMap = _sourceMap();
+		output["sourceMap"] = sourceMap ? *sourceMap : "";
+	}
+	if (_isRequested("linkReferences"))
+		output["linkReferences"] = formatLinkReferences(_object.linkReferences);
 	return output;
 }
 
+/// @returns the outputs selected in @a _outputSelection for the contract @a _contract in the
+/// source @a _file or, if @a _contract is empty, for the source itself.
+vector<string> selectedOutputs(Json::Value const& _outputSelection, string const& _file, string const& _contract)
+{
+	// Everything is generated if there is no selection.
+	if (!_outputSelection.isObject())
+		return vector<string>{"*"};
+
+	vector<string> outputs;
+	for (string const& file: {_file, string("*")})
+	{
+		Json::Value const& fileSelection = _outputSelection.get(file, Json::Value());
+		if (!fileSelection.isObject())
+			continue;
+		vector<string> contracts{_contract};
+		// The wildcard only selects contracts, not the source itself.
+		if (!_contract.empty())
+			contracts.push_back("*");
+		for (string const& contract: contracts)
+			for (auto const& output: fileSelection.get(contract, Json::Value()))
+				if (output.isString())
+					outputs.push_back(output.asString());
+	}
+	return outputs;
+}
+
+/// @returns true if @a _artifact (e.g. "evm.bytecode.object") or a part of it is contained in
+/// @a _outputs, either directly, through one of its parents or through the wildcard.
+bool isArtifactRequested(vector<string> const& _outputs, string const& _artifact)
+{
+	for (string const& output: _outputs)
+		if (
+			output == "*" ||
+			output == _artifact ||
+			boost::starts_with(_artifact, output + ".") ||
+			boost::starts_with(output, _artifact + ".")
+		)
+			return true;
+	return false;
+}
+
+/// @returns true if any of @a _outputs requires code to be generated.
+bool isCodeGenerationRequested(vector<string> const& _outputs)
+{
+	for (string const& artifact: {
+		"metadata",
+		"evm.assembly",
+		"evm.legacyAssembly",
+		"evm.gasEstimates",
+		"evm.bytecode",
+		"evm.deployedBytecode"
+	})
+		if (isArtifactRequested(_outputs, artifact))
+			return true;
+	return false;
+}
+
 }
 
 Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
@@ -169,6 +241,8 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		return formatFatalError("JSONError", "No input sources specified.");
 
 	Json::Value errors = Json::arrayValue;
+	// Names of the sources given in the input, their contents are only kept by the compiler stack.
+	set<string> inputSources;
 
 	for (auto const& sourceName: sources.getMemberNames())
 	{
@@ -191,7 +265,10 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				m_compilerStack.addSource(sourceName, content);
+			{
+				m_compilerStack.addSource(sourceName, move(content));
+				inputSources.insert(sourceName);
+			}
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -215,7 +292,8 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 						));
 					else
 					{
-						m_compilerStack.addSource(sourceName, result.contentsOrErrorMessage);
+						m_compilerStack.addSource(sourceName, move(result.contentsOrErrorMessage));
+						inputSources.insert(sourceName);
 						found = true;
 						break;
 					}
@@ -264,13 +342,62 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	m_compilerStack.useMetadataLiteralSources(metadataSettings.get("useLiteralContent", Json::Value(false)).asBool());
 	m_compilerStack.disableOnChainMetadata(metadataSettings.get("disableOnChainMetadata", Json::Value(false)).asBool());
 
+	m_compilerStack.setParallelism(settings.get("parallelism", Json::Value(1u)).asUInt());
+
+	string cacheDirectory = settings.get("cache", Json::Value()).get("directory", Json::Value(m_cacheDirectory)).asString();
+	shared_ptr<CompilationCache> cache;
+	h256 cacheKey;
+	// Inputs that already produced errors while loading the sources are not cached.
+	if (!cacheDirectory.empty() && errors.empty())
+	{
+		// Settings that do not influence the output are not part of the key.
+		Json::Value outputSettings = settings;
+		outputSettings.removeMember("cache");
+		outputSettings.removeMember("parallelism");
+		cache = make_shared<CompilationCache>(cacheDirectory, m_readFile);
+		StringMap sourceContents;
+		for (auto const& source: inputSources)
+			sourceContents[source] = m_compilerStack.scanner(source).source();
+		cacheKey = CompilationCache::key(sourceContents, outputSettings);
+		Json::Value cachedOutput = cache->load(cacheKey);
+		if (cachedOutput.isObject())
+			return cachedOutput;
+		m_compilerStack.setASTCache(
+			[cache](h256 const& _sourceHash) { return cache->loadAST(_sourceHash); },
+			[cache](h256 const& _sourceHash, bytes const& _ast) { cache->storeAST(_sourceHash, _ast); }
+		);
+	}
+	else
+		m_compilerStack.setASTCache(nullptr, nullptr);
+
 	auto scannerFromSourceName = [&](string const& _sourceName) -> solidity::Scanner const& { return m_compilerStack.scanner(_sourceName); };
 
+	Json::Value const& outputSelection = settings.get("outputSelection", Json::Value());
+	auto outputsOf = [&](string const& _contractName)
+	{
+		size_t colon = _contractName.find(':');
+		solAssert(colon != string::npos, "");
+		return selectedOutputs(outputSelection, _contractName.substr(0, colon), _contractName.substr(colon + 1));
+	};
+
 	bool success = false;
 
 	try
 	{
-		success = m_compilerStack.compile(optimize, optimizeRuns, libraries);
+		success = m_compilerStack.parseAndAnalyze();
+		if (success)
+		{
+			// Code is only generated for the contracts whose outputs need it (and their dependencies).
+			set<string> contractsToCompile;
+			for (string const& contractName: m_compilerStack.contractNames())
+				if (isCodeGenerationRequested(outputsOf(contractName)))
+					contractsToCompile.insert(contractName);
+			if (!contractsToCompile.empty())
+			{
+				m_compilerStack.setContractsToCompile(contractsToCompile);
+				success = m_compilerStack.compile(optimize, optimizeRuns, libraries);
+			}
+		}
 
 		for (auto const& error: m_compilerStack.errors())
 		{
@@ -368,10 +495,13 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	unsigned sourceIndex = 0;
 	for (auto const& source: m_compilerStack.sourceNames())
 	{
+		vector<string> outputs = selectedOutputs(outputSelection, source, "");
 		Json::Value sourceResult = Json::objectValue;
 		sourceResult["id"] = sourceIndex++;
-		sourceResult["ast"] = ASTJsonConverter(false, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(source));
-		sourceResult["legacyAST"] = ASTJsonConverter(true, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(source));
+		if (isArtifactRequested(outputs, "ast"))
+			sourceResult["ast"] = ASTJsonConverter(false, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(source));
+		if (isArtifactRequested(outputs, "legacyAST"))
+			sourceResult["legacyAST"] = ASTJsonConverter(true, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(source));
 		output["sources"][source] = sourceResult;
 	}
 
@@ -382,35 +512,55 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		solAssert(colon != string::npos, "");
 		string file = contractName.substr(0, colon);
 		string name = contractName.substr(colon + 1);
+		vector<string> outputs = outputsOf(contractName);
+		auto isRequested = [&](string const& _artifact) { return isArtifactRequested(outputs, _artifact); };
 
 		// ABI, documentation and metadata
 		Json::Value contractData(Json::objectValue);
-		contractData["abi"] = m_compilerStack.contractABI(contractName);
-		contractData["metadata"] = m_compilerStack.onChainMetadata(contractName);
-		contractData["userdoc"] = m_compilerStack.natspec(contractName, DocumentationType::NatspecUser);
-		contractData["devdoc"] = m_compilerStack.natspec(contractName, DocumentationType::NatspecDev);
+		if (isRequested("abi"))
+			contractData["abi"] = m_compilerStack.contractABI(contractName);
+		if (isRequested("metadata"))
+			contractData["metadata"] = m_compilerStack.onChainMetadata(contractName);
+		if (isRequested("userdoc"))
+			contractData["userdoc"] = m_compilerStack.natspec(contractName, DocumentationType::NatspecUser);
+		if (isRequested("devdoc"))
+			contractData["devdoc"] = m_compilerStack.natspec(contractName, DocumentationType::NatspecDev);
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
 		// @TODO: add ir
 		ostringstream tmp;
-		m_compilerStack.streamAssembly(tmp, contractName, createSourceList(_input), false);
-		evmData["assembly"] = tmp.str();
-		evmData["legacyAssembly"] = m_compilerStack.streamAssembly(tmp, contractName, createSourceList(_input), true);
-		evmData["methodIdentifiers"] = m_compilerStack.methodIdentifiers(contractName);
-		evmData["gasEstimates"] = m_compilerStack.gasEstimates(contractName);
-
-		evmData["bytecode"] = collectEVMObject(
-			m_compilerStack.object(contractName),
-			m_compilerStack.sourceMapping(contractName)
-		);
-
-		evmData["deployedBytecode"] = collectEVMObject(
-			m_compilerStack.runtimeObject(contractName),
-			m_compilerStack.runtimeSourceMapping(contractName)
-		);
-
-		contractData["evm"] = evmData;
+		if (isRequested("evm.assembly"))
+		{
+			m_compilerStack.streamAssembly(tmp, contractName, createSourceList(_input), false);
+			evmData["assembly"] = tmp.str();
+		}
+		if (isRequested("evm.legacyAssembly"))
+			evmData["legacyAssembly"] = m_compilerStack.streamAssembly(tmp, contractName, createSourceList(_input), true);
+		if (isRequested("evm.methodIdentifiers"))
+			evmData["methodIdentifiers"] = m_compilerStack.methodIdentifiers(contractName);
+		if (isRequested("evm.gasEstimates"))
+			evmData["gasEstimates"] = m_compilerStack.gasEstimates(contractName);
+
+		if (isRequested("evm.bytecode"))
+			evmData["bytecode"] = collectEVMObject(
+				m_compilerStack.object(contractName),
+				[&]() { return m_compilerStack.sourceMapping(contractName); },
+				[&](string const& _part) { return isRequested("evm.bytecode." + _part); }
+			);
+
+		if (isRequested("evm.deployedBytecode"))
+			evmData["deployedBytecode"] = collectEVMObject(
+				m_compilerStack.runtimeObject(contractName),
+				[&]() { return m_compilerStack.runtimeSourceMapping(contractName); },
+				[&](string const& _part) { return isRequested("evm.deployedBytecode." + _part); }
+			);
+
+		if (!evmData.empty())
+			contractData["evm"] = evmData;
+
+		if (contractData.empty())
+			continue;
 
 		if (!contractsOutput.isMember(file))
 			contractsOutput[file] = Json::objectValue;
@@ -419,6 +569,15 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	}
 	output["contracts"] = contractsOutput;
 
+	if (cache && success)
+	{
+		StringMap importedSources;
+		for (auto const& source: m_compilerStack.sourceNames())
+			if (!inputSources.count(source))
+				importedSources[source] = m_compilerStack.scanner(source).source();
+		cache->store(cacheKey, output, importedSources);
+	}
+
 	return output;
 }
 
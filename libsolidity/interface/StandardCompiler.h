@@ -52,11 +52,16 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input);
 
+	/// Sets the directory of a persistent cache for compilation results, which is used unless
+	/// the input specifies one itself. An empty string disables the cache.
+	void setCacheDirectory(std::string const& _directory) { m_cacheDirectory = _directory; }
+
 private:
 	Json::Value compileInternal(Json::Value const& _input);
 
 	CompilerStack m_compilerStack;
 	ReadFile::Callback m_readFile;
+	std::string m_cacheDirectory;
 };
 
 }
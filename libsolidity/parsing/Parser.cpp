@@ -56,6 +56,8 @@ public:
 	{
 		if (m_location.end < 0)
 			markEndPosition();
+		if (m_parser.m_arena)
+			return m_parser.m_arena->create<NodeType>(m_location, forward<Args>(_args)...);
 		return make_shared<NodeType>(m_location, forward<Args>(_args)...);
 	}
 
@@ -1502,7 +1504,10 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier =
+		m_arena ?
+		allocate_shared<ASTString>(ASTArena::Allocator<ASTString>(m_arena), m_scanner->currentLiteral()) :
+		make_shared<ASTString>(m_scanner->currentLiteral());
 	m_scanner->next();
 	return identifier;
 }
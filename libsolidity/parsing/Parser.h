@@ -35,7 +35,9 @@ class Scanner;
 class Parser: public ParserBase
 {
 public:
-	Parser(ErrorReporter& _errorReporter): ParserBase(_errorReporter) {}
+	/// @param _arena if given, all AST nodes are allocated inside this arena.
+	explicit Parser(ErrorReporter& _errorReporter, std::shared_ptr<ASTArena> _arena = nullptr):
+		ParserBase(_errorReporter), m_arena(std::move(_arena)) {}
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<Scanner> const& _scanner);
 
@@ -166,6 +168,7 @@ private:
 
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
+	std::shared_ptr<ASTArena> m_arena;
 };
 
 }
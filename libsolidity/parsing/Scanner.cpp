@@ -51,6 +51,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <tuple>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/parsing/Scanner.h>
@@ -236,20 +237,23 @@ Token::Value Scanner::selectToken(char _next, Token::Value _then, Token::Value _
 
 bool Scanner::skipWhitespace()
 {
-	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	// m_char is not necessarily the character at the current position (see skipMultiLineComment),
+	// so it is checked separately before the rest is skipped in bulk.
+	if (!isWhiteSpace(m_char))
+		return false;
+	advance();
+	m_char = m_source.advanceWhile(isWhiteSpace);
+	return true;
 }
 
 bool Scanner::skipWhitespaceExceptLF()
 {
-	int const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isLineTerminator(m_char))
-		advance();
-	// Return whether or not we skipped any characters.
-	return sourcePos() != startPosition;
+	auto isWhiteSpaceExceptLF = [](char _c) { return isWhiteSpace(_c) && !isLineTerminator(_c); };
+	if (!isWhiteSpaceExceptLF(m_char))
+		return false;
+	advance();
+	m_char = m_source.advanceWhile(isWhiteSpaceExceptLF);
+	return true;
 }
 
 Token::Value Scanner::skipSingleLineComment()
@@ -258,8 +262,8 @@ Token::Value Scanner::skipSingleLineComment()
 	// to be part of the single-line comment; it is recognized
 	// separately by the lexical grammar and becomes part of the
 	// stream of input elements for the syntactic grammar
-	while (!isLineTerminator(m_char))
-		if (!advance()) break;
+	if (!isLineTerminator(m_char) && advance())
+		m_char = m_source.advanceTo('\n');
 
 	return Token::Whitespace;
 }
@@ -299,13 +303,15 @@ Token::Value Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
-		char ch = m_char;
-		advance();
+		// Only a '*' can end the comment, everything up to it is skipped in bulk.
+		m_char = m_source.advanceTo('*');
+		if (!advance())
+			break;
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			m_char = ' ';
 			return Token::Whitespace;
@@ -801,10 +807,11 @@ tuple<Token::Value, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char)) //get full literal
-		addLiteralCharAndAdvance();
+	int const startPosition = sourcePos();
+	advance();
+	// Scan the rest of the identifier characters and copy the full literal at once.
+	m_char = m_source.advanceWhile(isIdentifierPart);
+	m_nextToken.literal.assign(m_source.source(), startPosition, sourcePos() - startPosition);
 	literal.complete();
 	return Token::fromIdentifierOrKeyword(m_nextToken.literal);
 }
@@ -816,7 +823,22 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return m_data[m_position];
+}
+
+char CharStream::advanceTo(char _char)
+{
+	if (isPastEndOfInput())
+		return 0;
+	// memchr is vectorised by the C library, which makes a difference for long comments.
+	void const* found = memchr(m_data + m_position, _char, m_size - m_position);
+	if (!found)
+	{
+		m_position = m_size;
+		return 0;
+	}
+	m_position = static_cast<char const*>(found) - m_data;
+	return _char;
 }
 
 char CharStream::rollback(size_t _amount)
@@ -826,38 +848,51 @@ char CharStream::rollback(size_t _amount)
 	return get();
 }
 
+vector<size_t> const& CharStream::lineStarts() const
+{
+	call_once(m_lineStarts->built, [&]()
+	{
+		vector<size_t>& offsets = m_lineStarts->offsets;
+		offsets.push_back(0);
+		char const* end = m_data + m_size;
+		for (char const* position = m_data; position < end; ++position)
+		{
+			position = static_cast<char const*>(memchr(position, '\n', end - position));
+			if (!position)
+				break;
+			offsets.push_back(position - m_data + 1);
+		}
+	});
+	return m_lineStarts->offsets;
+}
+
+size_t CharStream::lineIndex(size_t _offset) const
+{
+	vector<size_t> const& offsets = lineStarts();
+	// The first line starts at zero, so the result is never the beginning.
+	return upper_bound(offsets.begin(), offsets.end(), _offset) - offsets.begin() - 1;
+}
+
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), _position);
+	size_t searchStart = min<size_t>(m_size, _position);
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	return m_source.substr(lineStart, min(m_source.find('\n', lineStart),
-										  m_source.size()) - lineStart);
+	// The line of the character at searchStart, or the next one if that character is \n.
+	size_t line = lineIndex(min(searchStart + 1, m_size));
+	vector<size_t> const& offsets = lineStarts();
+	size_t lineStart = offsets[line];
+	size_t lineEnd = line + 1 < offsets.size() ? offsets[line + 1] - 1 : m_size;
+	return m_source->substr(lineStart, lineEnd - lineStart);
 }
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	size_type searchPosition = min<size_type>(m_source.size(), _position);
-	int lineNumber = count(m_source.begin(), m_source.begin() + searchPosition, '\n');
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	size_t searchPosition = min<size_t>(m_size, _position);
+	size_t line = lineIndex(searchPosition);
+	return tuple<int, int>(line, searchPosition - lineStarts()[line]);
 }
 
-
 }
 }
@@ -57,6 +57,9 @@
 #include <libevmasm/SourceLocation.h>
 #include <libsolidity/parsing/Token.h>
 
+#include <mutex>
+#include <vector>
+
 namespace dev
 {
 namespace solidity
@@ -70,29 +73,71 @@ class ParserRecorder;
 class CharStream
 {
 public:
-	CharStream(): m_position(0) {}
-	explicit CharStream(std::string const& _source): m_source(_source), m_position(0) {}
+	CharStream(): CharStream(std::string()) {}
+	explicit CharStream(std::string _source):
+		CharStream(std::make_shared<std::string const>(std::move(_source))) {}
+	/// Creates a stream on a buffer that is shared with all copies of the stream and with
+	/// everyone else who holds @a _source, the text is not copied.
+	explicit CharStream(std::shared_ptr<std::string const> _source):
+		m_source(std::move(_source)),
+		m_data(m_source->data()),
+		m_size(m_source->size()),
+		m_position(0),
+		m_lineStarts(std::make_shared<LineStarts>())
+	{}
 	int position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_size; }
+	char get(size_t _charsForward = 0) const { return m_data[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars=1);
 	char rollback(size_t _amount);
+	/// Advances over all characters satisfying @a _predicate, starting at the current position.
+	/// @returns the first other character, or zero at the end of the input.
+	template <class Predicate>
+	char advanceWhile(Predicate _predicate)
+	{
+		// Works on the buffer directly, the bounds are only checked once per character.
+		while (m_position < m_size && _predicate(m_data[m_position]))
+			++m_position;
+		return m_position < m_size ? m_data[m_position] : 0;
+	}
+	/// Advances to the next occurrence of @a _char, starting at the current position.
+	/// @returns @a _char or zero if it does not occur until the end of the input.
+	char advanceTo(char _char);
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const { return m_source; }
+	std::string const& source() const { return *m_source; }
+	std::shared_ptr<std::string const> const& sharedSource() const { return m_source; }
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and translating source locations.
+	/// The first call builds an index of the line starts, which is shared by all copies of
+	/// the stream, later calls only search it.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
-	std::string m_source;
+	struct LineStarts
+	{
+		std::once_flag built;
+		std::vector<size_t> offsets;
+	};
+
+	/// @returns the offsets of the starts of all lines, built on first use. Safe to be called
+	/// concurrently.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line containing the character at @a _offset, which must not
+	/// be larger than the size of the source.
+	size_t lineIndex(size_t _offset) const;
+
+	std::shared_ptr<std::string const> m_source;
+	/// Cached from @a m_source for the hot scanning functions, the buffer is immutable.
+	char const* m_data;
+	size_t m_size;
 	size_t m_position;
+	std::shared_ptr<LineStarts> m_lineStarts;
 };
 
 
@@ -104,7 +149,8 @@ public:
 
 	explicit Scanner(CharStream const& _source = CharStream(), std::string const& _sourceName = "") { reset(_source, _sourceName); }
 
-	std::string source() const { return m_source.source(); }
+	std::string const& source() const { return m_source.source(); }
+	std::shared_ptr<std::string const> const& sharedSource() const { return m_source.sharedSource(); }
 
 	/// Resets the scanner as if newly constructed with _source and _sourceName as input.
 	void reset(CharStream const& _source, std::string const& _sourceName);
@@ -158,8 +204,7 @@ public:
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and translating source locations.
 	std::string lineAtPosition(int _position) const { return m_source.lineAtPosition(_position); }
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const { return m_source.translatePositionToLineColumn(_position); }
 	///@}
@@ -40,9 +40,9 @@
 // You should have received a copy of the GNU General Public License
 // along with solidity.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <map>
+#include <array>
+#include <cstring>
 #include <libsolidity/parsing/Token.h>
-#include <boost/range/iterator_range.hpp>
 
 using namespace std;
 
@@ -110,36 +110,121 @@ char const Token::m_tokenType[] =
 	TOKEN_LIST(KT, KK)
 };
 
-int Token::parseSize(string::const_iterator _begin, string::const_iterator _end)
+namespace
 {
-	try
+
+/// Perfect hash table of the keywords in TOKEN_LIST. It is built on first use by searching for
+/// a seed of the hash function that maps all keywords to different slots, so that a lookup
+/// hashes the name once and compares it to at most one keyword.
+class KeywordTable
+{
+public:
+	KeywordTable()
 	{
-		unsigned int m = boost::lexical_cast<int>(boost::make_iterator_range(_begin, _end));
-		return m;
+		// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be
+		// ignored and keywords to be put inside the keywords variable.
+#define KEYWORD(name, string, precedence) {string, Token::name},
+#define TOKEN(name, string, precedence)
+		vector<pair<char const*, Token::Value>> const keywords{TOKEN_LIST(TOKEN, KEYWORD)};
+#undef KEYWORD
+#undef TOKEN
+		for (auto const& keyword: keywords)
+			m_maxLength = max(m_maxLength, strlen(keyword.first));
+		for (m_seed = 0; !tryBuild(keywords); ++m_seed) {}
 	}
-	catch(boost::bad_lexical_cast const&)
+
+	Token::Value find(char const* _begin, size_t _length) const
 	{
+		if (_length == 0 || _length > m_maxLength)
+			return Token::Identifier;
+		Entry const& entry = m_entries[hash(_begin, _length)];
+		if (entry.length == _length && memcmp(entry.name, _begin, _length) == 0)
+			return entry.token;
+		return Token::Identifier;
+	}
+
+private:
+	static size_t const c_size = 1024;
+
+	struct Entry
+	{
+		char const* name = nullptr;
+		size_t length = 0;
+		Token::Value token = Token::Identifier;
+	};
+
+	size_t hash(char const* _begin, size_t _length) const
+	{
+		uint32_t h = 2166136261u ^ m_seed ^ uint32_t(_length);
+		for (size_t i = 0; i < _length; ++i)
+			h = (h ^ uint8_t(_begin[i])) * 16777619u;
+		return (h ^ (h >> 16)) % c_size;
+	}
+
+	bool tryBuild(vector<pair<char const*, Token::Value>> const& _keywords)
+	{
+		m_entries.fill(Entry());
+		for (auto const& keyword: _keywords)
+		{
+			size_t length = strlen(keyword.first);
+			Entry& entry = m_entries[hash(keyword.first, length)];
+			if (entry.name)
+			{
+				// Keep the first of duplicate names, but restart on collisions.
+				if (entry.length == length && memcmp(entry.name, keyword.first, length) == 0)
+					continue;
+				return false;
+			}
+			entry.name = keyword.first;
+			entry.length = length;
+			entry.token = keyword.second;
+		}
+		return true;
+	}
+
+	uint32_t m_seed = 0;
+	size_t m_maxLength = 0;
+	array<Entry, c_size> m_entries;
+};
+
+}
+
+int Token::parseSize(char const* _begin, char const* _end)
+{
+	if (_begin == _end)
 		return -1;
+	unsigned m = 0;
+	for (char const* it = _begin; it != _end; ++it)
+	{
+		if (*it < '0' || '9' < *it)
+			return -1;
+		m = m * 10 + unsigned(*it - '0');
+		if (m > 0xffff)
+			// Far larger than any valid size.
+			return -1;
 	}
+	return m;
 }
 
 tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(string const& _literal)
 {
-	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
-	if (positionM != _literal.end())
+	char const* begin = _literal.data();
+	char const* end = begin + _literal.size();
+	auto isDigit = [](char _c) { return '0' <= _c && _c <= '9'; };
+	char const* positionM = find_if(begin, end, isDigit);
+	if (positionM != end)
 	{
-		string baseType(_literal.begin(), positionM);
-		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
+		char const* positionX = find_if_not(positionM, end, isDigit);
 		int m = parseSize(positionM, positionX);
-		Token::Value keyword = keywordByName(baseType);
+		Token::Value keyword = keywordByName(begin, positionM - begin);
 		if (keyword == Token::Bytes)
 		{
-			if (0 < m && m <= 32 && positionX == _literal.end())
+			if (0 < m && m <= 32 && positionX == end)
 				return make_tuple(Token::BytesM, m, 0);
 		}
 		else if (keyword == Token::UInt || keyword == Token::Int)
 		{
-			if (0 < m && m <= 256 && m % 8 == 0 && positionX == _literal.end())
+			if (0 < m && m <= 256 && m % 8 == 0 && positionX == end)
 			{
 				if (keyword == Token::UInt)
 					return make_tuple(Token::UIntM, m, 0);
@@ -151,11 +236,11 @@ tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(s
 		{
 			if (
 				positionM < positionX &&
-				positionX < _literal.end() &&
+				positionX < end &&
 				*positionX == 'x' &&
-				all_of(positionX + 1, _literal.end(), ::isdigit)
+				all_of(positionX + 1, end, isDigit)
 			) {
-				int n = parseSize(positionX + 1, _literal.end());
+				int n = parseSize(positionX + 1, end);
 				if (
 					0 <= m && m <= 256 &&
 					8 <= n && n <= 256 &&
@@ -174,19 +259,13 @@ tuple<Token::Value, unsigned int, unsigned int> Token::fromIdentifierOrKeyword(s
 		return make_tuple(Token::Identifier, 0, 0);
 	}
 
-	return make_tuple(keywordByName(_literal), 0, 0);
+	return make_tuple(keywordByName(begin, _literal.size()), 0, 0);
 }
-Token::Value Token::keywordByName(string const& _name)
+
+Token::Value Token::keywordByName(char const* _name, size_t _length)
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
-#define KEYWORD(name, string, precedence) {string, Token::name},
-#define TOKEN(name, string, precedence)
-	static const map<string, Token::Value> keywords({TOKEN_LIST(TOKEN, KEYWORD)});
-#undef KEYWORD
-#undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+	static KeywordTable const keywords;
+	return keywords.find(_name, _length);
 }
 
 #undef KT
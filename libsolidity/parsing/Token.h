@@ -315,9 +315,10 @@ public:
 
 private:
 	// @returns -1 on error (invalid digit or number too large)
-	static int parseSize(std::string::const_iterator _begin, std::string::const_iterator _end);
-	// @returns the keyword with name @a _name or Token::Identifier of no such keyword exists.
-	static Token::Value keywordByName(std::string const& _name);
+	static int parseSize(char const* _begin, char const* _end);
+	// @returns the keyword with the name of length @a _length at @a _name or Token::Identifier
+	// if no such keyword exists.
+	static Token::Value keywordByName(char const* _name, size_t _length);
 	static char const* const m_name[NUM_TOKENS];
 	static char const* const m_string[NUM_TOKENS];
 	static int8_t const m_precedence[NUM_TOKENS];
@@ -34,6 +34,7 @@
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilerServer.h>
 #include <libsolidity/interface/SourceReferenceFormatter.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/AssemblyStack.h>
@@ -79,6 +80,7 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCloneBinary = "clone-bin";
@@ -93,6 +95,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strJulia = "julia";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
@@ -107,6 +110,7 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -124,6 +128,7 @@ static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCloneBinary = g_strCloneBinary;
@@ -133,6 +138,7 @@ static string const g_argFormal = g_strFormal;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argJulia = "julia";
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
@@ -146,6 +152,7 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argVersion = g_strVersion;
@@ -428,14 +435,7 @@ void CommandLineInterface::readInputFilesAndConfigureRemappings()
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-	{
-		string s;
-		while (!cin.eof())
-		{
-			getline(cin, s);
-			m_sourceCodes[g_stdinFileName].append(s + '\n');
-		}
-	}
+		m_sourceCodes[g_stdinFileName] = dev::readStandardInput();
 }
 
 bool CommandLineInterface::parseLibraryOption(string const& _input)
@@ -540,6 +540,14 @@ Allowed options)",
 			po::value<unsigned>()->value_name("n")->default_value(200),
 			"Estimated number of contract runs for optimizer tuning."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to generate code for independent contracts and to optimise "
+			"independent blocks in parallel. "
+			"In server mode, the number of requests compiled concurrently. "
+			"Zero uses one thread per CPU core."
+		)
 		(g_argAddStandard.c_str(), "Add standard contracts.")
 		(
 			g_argLibraries.c_str(),
@@ -565,6 +573,18 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to server mode: Read Standard JSON requests, each preceded by a "
+			"\"Content-Length: <bytes>\" header and an empty line, from standard input until it is "
+			"closed and write the responses in the same format and order to standard output."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory of a persistent cache for Standard JSON compilation results and the parsed "
+			"sources. Hit and miss counts are recorded in statistics.json in that directory."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine and assumes input is assembly."
@@ -664,7 +684,8 @@ Allowed options)",
 
 bool CommandLineInterface::processInput()
 {
-	ReadFile::Callback fileReader = [this](string const& _path)
+	// Does not record the sources it reads, so it can be used concurrently.
+	ReadFile::Callback readFile = [this](string const& _path)
 	{
 		try
 		{
@@ -691,9 +712,7 @@ bool CommandLineInterface::processInput()
 				return ReadFile::Result{false, "Not a valid file."};
 			else
 			{
-				auto contents = dev::contentsString(canonicalPath.string());
-				m_sourceCodes[path.string()] = contents;
-				return ReadFile::Result{true, contents};
+				return ReadFile::Result{true, dev::contentsString(canonicalPath.string())};
 			}
 		}
 		catch (Exception const& _exception)
@@ -705,6 +724,13 @@ bool CommandLineInterface::processInput()
 			return ReadFile::Result{false, "Unknown exception in read callback."};
 		}
 	};
+	ReadFile::Callback fileReader = [this, readFile](string const& _path)
+	{
+		ReadFile::Result result = readFile(_path);
+		if (result.success)
+			m_sourceCodes[_path] = result.contentsOrErrorMessage;
+		return result;
+	};
 
 	if (m_args.count(g_argAllowPaths))
 	{
@@ -715,18 +741,31 @@ bool CommandLineInterface::processInput()
 
 	if (m_args.count(g_argStandardJSON))
 	{
-		string input;
-		while (!cin.eof())
-		{
-			string tmp;
-			getline(cin, tmp);
-			input.append(tmp + "\n");
-		}
+		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_argCacheDir))
+			compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
 		cout << compiler.compile(input) << endl;
 		return true;
 	}
 
+	if (m_args.count(g_argServer))
+	{
+		// The sources read for a request are part of its response only, they are not recorded
+		// for the lifetime of the server.
+		CompilerServer server(
+			readFile,
+			m_args[g_argJobs].as<unsigned>(),
+			m_args.count(g_argCacheDir) ? m_args[g_argCacheDir].as<string>() : ""
+		);
+		if (!server.serve(cin, cout))
+		{
+			cerr << "Invalid request framing in server mode." << endl;
+			return false;
+		}
+		return true;
+	}
+
 	readInputFilesAndConfigureRemappings();
 
 	if (m_args.count(g_argLibraries))
@@ -776,6 +815,7 @@ bool CommandLineInterface::processInput()
 			m_compiler->disableOnChainMetadata(true);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_args[g_argInputFile].as<vector<string>>());
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
 		for (auto const& sourceCode: m_sourceCodes)
 			m_compiler->addSource(sourceCode.first, sourceCode.second);
 		// TODO: Perhaps we should not compile unless requested
@@ -982,7 +1022,7 @@ void CommandLineInterface::handleAst(string const& _argStr)
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
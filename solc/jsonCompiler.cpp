@@ -21,9 +21,13 @@
  */
 
 #include <string>
+#include <future>
+#include <mutex>
+#include <vector>
 #include <libdevcore/Common.h>
 #include <libdevcore/JSON.h>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilerServer.h>
 #include <libsolidity/interface/Version.h>
 
 #include "license.h"
@@ -264,6 +268,52 @@ string compileStandardInternal(string const& _input, CStyleReadFileCallback _rea
 	return compiler.compile(_input);
 }
 
+string compileStandardBatchInternal(string const& _input, CStyleReadFileCallback _readCallback, unsigned _threads)
+{
+	Json::Value inputs;
+	if (!Json::Reader().parse(_input, inputs, false) || !inputs.isArray())
+	{
+		Json::Value error = Json::objectValue;
+		error["type"] = "JSONError";
+		error["component"] = "general";
+		error["severity"] = "error";
+		error["message"] = "Input is not a JSON array.";
+		error["formattedMessage"] = "Input is not a JSON array.";
+		Json::Value output = Json::objectValue;
+		output["errors"] = Json::arrayValue;
+		output["errors"].append(error);
+		return jsonCompactPrint(output);
+	}
+
+	// The workers must not call back concurrently.
+	ReadFile::Callback readCallback = wrapReadCallback(_readCallback);
+	mutex readCallbackMutex;
+	ReadFile::Callback serializedReadCallback;
+	if (readCallback)
+		serializedReadCallback = [&](string const& _path)
+		{
+			lock_guard<mutex> lock(readCallbackMutex);
+			return readCallback(_path);
+		};
+
+	CompilerServer server(serializedReadCallback, _threads);
+	vector<future<CompilerServer::Result>> results;
+	for (auto const& input: inputs)
+		results.push_back(server.submit(jsonCompactPrint(input)));
+
+	// The outputs are already serialized, so they are inserted textually instead of being
+	// parsed again.
+	string output = "[";
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		CompilerServer::Result result = results[i].get();
+		if (i > 0)
+			output += ",";
+		output += "{\"output\":" + result.output + ",\"time\":" + jsonCompactPrint(Json::Value(result.milliseconds)) + "}";
+	}
+	return output + "]";
+}
+
 static string s_outputBuffer;
 
 extern "C"
@@ -297,4 +347,12 @@ extern char const* compileStandard(char const* _input, CStyleReadFileCallback _r
 	s_outputBuffer = compileStandardInternal(_input, _readCallback);
 	return s_outputBuffer.c_str();
 }
+/// Compiles a JSON array of Standard JSON inputs on @a _threads threads (zero for one per CPU core).
+/// @returns a JSON array with an object {"output": <Standard JSON output>, "time": <milliseconds>}
+/// for each input, in the same order.
+extern char const* compileStandardBatch(char const* _input, CStyleReadFileCallback _readCallback, unsigned _threads)
+{
+	s_outputBuffer = compileStandardBatchInternal(_input, _readCallback, _threads);
+	return s_outputBuffer.c_str();
+}
 }
@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include "../TestHelper.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(nested_loops)
+{
+	ThreadPool pool(3);
+	BOOST_CHECK_EQUAL(pool.threads(), 3);
+	mutex threadsMutex;
+	set<thread::id> threads;
+	atomic<unsigned> running(0);
+	atomic<unsigned> maxRunning(0);
+	vector<atomic<unsigned>> calls(4 * 5 * 6);
+	pool.parallelFor(4, [&](size_t _i)
+	{
+		pool.parallelFor(5, [&](size_t _j)
+		{
+			pool.parallelFor(6, [&](size_t _k)
+			{
+				unsigned now = ++running;
+				unsigned highest = maxRunning;
+				while (now > highest && !maxRunning.compare_exchange_weak(highest, now)) {}
+				{
+					lock_guard<mutex> lock(threadsMutex);
+					threads.insert(this_thread::get_id());
+				}
+				calls[(_i * 5 + _j) * 6 + _k]++;
+				running--;
+			});
+		});
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(unsigned(count), 1);
+	BOOST_CHECK(threads.size() <= 3);
+	BOOST_CHECK(maxRunning <= 3);
+}
+
+BOOST_AUTO_TEST_CASE(first_exception)
+{
+	for (unsigned threads: {1u, 4u})
+	{
+		ThreadPool pool(threads);
+		atomic<unsigned> calls(0);
+		auto body = [&](size_t _i)
+		{
+			calls++;
+			if (_i % 10 == 7)
+				throw runtime_error(to_string(_i));
+		};
+		try
+		{
+			pool.parallelFor(30, body);
+			BOOST_FAIL("Exception expected.");
+		}
+		catch (runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(_error.what(), string("7"));
+		}
+		// Without workers, the loop stops at the first exception.
+		BOOST_CHECK_EQUAL(unsigned(calls), threads == 1 ? 8 : 30);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
@@ -0,0 +1,215 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Tests for the binary AST format and the AST cache of the compiler stack.
+ */
+
+#include <libsolidity/ast/ASTBinaryConverter.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/parsing/Scanner.h>
+
+#include <libdevcore/JSON.h>
+#include <libdevcore/SHA3.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+string const c_library = R"(
+	library L { function inc(uint x) returns (uint) { return x + 1; } }
+)";
+
+string const c_contract = R"(
+	pragma solidity >=0.0;
+	import "b";
+	import "b" as B;
+	import {L as M, L} from "b";
+	contract D { uint public d; function D(uint _d) { d = _d; } function g(uint y) payable {} }
+	contract E { function E(bytes32) {} }
+	/// @title C
+	contract C is D(2) {
+		using L for uint;
+		struct S { uint a; mapping(uint => uint[]) m; }
+		enum Kind { X, Y }
+		event Ev(uint indexed a, bytes32 b) anonymous;
+		uint constant k = 1 ether;
+		function(uint) external returns (uint) fp;
+		S s;
+		modifier mod(uint x) { require(x > 0); _; }
+		/// @notice Does things with @param a and @param b
+		function f(uint a, uint[] memory b) mod(a) payable returns (uint r) {
+			var (x, , z) = (1, 2, 3);
+			uint[3] memory arr = [uint(1), 2, 3];
+			for (uint i = 0; i < a; i++) { if (i == 2) continue; else break; }
+			while (a > 0) a--;
+			do { a -= 1; } while (false);
+			r = a > 1 ? a : z;
+			r += ~uint(x) + b.length + 2 days + a.inc() + M.inc(B.L.inc(1));
+			E e = new E("\x01");
+			this.g.value(1)({y: 1});
+			s.m[1].push(uint(Kind.Y));
+			delete s.a;
+			assembly { let t := mload(0x40) mstore(t, a) }
+			if (a == 7) throw;
+			return k + arr[0] + uint(keccak256(e));
+		}
+		function g(uint y) payable {}
+		function h();
+	}
+)";
+
+/// AST store in memory that counts its hits. It is used by sources parsed in parallel.
+struct MemoryASTCache
+{
+	map<h256, bytes> entries;
+	size_t hits = 0;
+	std::mutex mutex;
+
+	void attach(CompilerStack& _compiler)
+	{
+		_compiler.setASTCache(
+			[this](h256 const& _hash) -> bytes
+			{
+				lock_guard<std::mutex> lock(mutex);
+				if (!entries.count(_hash))
+					return bytes();
+				hits++;
+				return entries[_hash];
+			},
+			[this](h256 const& _hash, bytes const& _ast)
+			{
+				lock_guard<std::mutex> lock(mutex);
+				entries[_hash] = _ast;
+			}
+		);
+	}
+};
+
+string astJson(CompilerStack const& _compiler, string const& _source)
+{
+	map<string, unsigned> sourceIndices;
+	sourceIndices[_source] = 0;
+	return jsonCompactPrint(ASTJsonConverter(true, sourceIndices).toJson(_compiler.ast(_source)));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityASTBinary)
+
+BOOST_AUTO_TEST_CASE(round_trip_through_cache)
+{
+	MemoryASTCache cache;
+	CompilerStack parsed;
+	cache.attach(parsed);
+	parsed.addSource("a", c_contract);
+	parsed.addSource("b", c_library);
+	BOOST_REQUIRE(parsed.compile());
+	BOOST_CHECK_EQUAL(cache.entries.size(), 2);
+	BOOST_CHECK_EQUAL(cache.hits, 0);
+
+	for (unsigned threads: {1u, 2u})
+	{
+		CompilerStack loaded;
+		cache.attach(loaded);
+		loaded.setParallelism(threads);
+		loaded.addSource("a", c_contract);
+		loaded.addSource("b", c_library);
+		size_t hits = cache.hits;
+		BOOST_REQUIRE(loaded.compile());
+		BOOST_CHECK_EQUAL(cache.hits, hits + 2);
+		// The annotations (types, referenced declarations, ...) are part of the legacy output.
+		BOOST_CHECK_EQUAL(astJson(loaded, "a"), astJson(parsed, "a"));
+		BOOST_CHECK_EQUAL(astJson(loaded, "b"), astJson(parsed, "b"));
+		BOOST_CHECK_EQUAL(loaded.ast("a").id(), parsed.ast("a").id());
+		BOOST_CHECK(loaded.object("C").bytecode == parsed.object("C").bytecode);
+		BOOST_CHECK(loaded.runtimeObject("C").bytecode == parsed.runtimeObject("C").bytecode);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+	MemoryASTCache cache;
+	CompilerStack parsed;
+	cache.attach(parsed);
+	parsed.addSource("a", c_contract);
+	parsed.addSource("b", c_library);
+	BOOST_REQUIRE(parsed.compile());
+	BOOST_REQUIRE_EQUAL(cache.entries.size(), 2);
+
+	Scanner scanner(CharStream(c_contract), "a");
+	bytes const& binary = cache.entries[keccak256(c_contract)];
+	BOOST_REQUIRE(ASTBinaryConverter::fromBinary(&binary, scanner));
+	size_t lastID = ASTNode::lastID();
+	for (size_t length: {size_t(0), size_t(5), binary.size() / 2, binary.size() - 1})
+	{
+		bytes truncated(binary.begin(), binary.begin() + length);
+		BOOST_CHECK(!ASTBinaryConverter::fromBinary(&truncated, scanner));
+		BOOST_CHECK_EQUAL(ASTNode::lastID(), lastID);
+	}
+	bytes otherFormat = binary;
+	// The format version follows the magic string.
+	otherFormat[6]++;
+	BOOST_CHECK(!ASTBinaryConverter::fromBinary(&otherFormat, scanner));
+	bytes trailing = binary + bytes{0};
+	BOOST_CHECK(!ASTBinaryConverter::fromBinary(&trailing, scanner));
+	// The number of IDs follows the version string, it is set to one without changing its length,
+	// so the IDs of the nodes would be those of preceding sources.
+	bytes fewerIDs = binary;
+	size_t position = 6 + 1 + 1 + string(VersionString).size();
+	BOOST_REQUIRE(fewerIDs[position] & 0x80);
+	fewerIDs[position] = 0x81;
+	while (fewerIDs[++position] & 0x80)
+		fewerIDs[position] = 0x80;
+	fewerIDs[position] = 0;
+	BOOST_CHECK(!ASTBinaryConverter::fromBinary(&fewerIDs, scanner));
+	BOOST_CHECK_EQUAL(ASTNode::lastID(), lastID);
+
+	// The compiler stack parses sources whose stored AST cannot be loaded.
+	for (auto& entry: cache.entries)
+		entry.second.resize(entry.second.size() / 2);
+	CompilerStack loaded;
+	cache.attach(loaded);
+	loaded.addSource("a", c_contract);
+	loaded.addSource("b", c_library);
+	BOOST_REQUIRE(loaded.compile());
+	BOOST_CHECK_EQUAL(cache.hits, 2);
+	BOOST_CHECK(loaded.object("C").bytecode == parsed.object("C").bytecode);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
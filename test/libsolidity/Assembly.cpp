@@ -32,6 +32,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/interface/ErrorReporter.h>
+#include <libsolidity/interface/CompilerStack.h>
 
 using namespace std;
 using namespace dev::eth;
@@ -46,13 +47,14 @@ namespace test
 namespace
 {
 
-eth::AssemblyItems compileContract(const string& _sourceCode)
+/// Items do not keep the name of their source alive, so @a _scanner has to outlive them.
+eth::AssemblyItems compileContract(shared_ptr<Scanner> const& _scanner)
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	Parser parser(errorReporter);
 	ASTPointer<SourceUnit> sourceUnit;
-	BOOST_REQUIRE_NO_THROW(sourceUnit = parser.parse(make_shared<Scanner>(CharStream(_sourceCode))));
+	BOOST_REQUIRE_NO_THROW(sourceUnit = parser.parse(_scanner));
 	BOOST_CHECK(!!sourceUnit);
 
 	map<ASTNode const*, shared_ptr<DeclarationContainer>> scopes;
@@ -91,12 +93,13 @@ void checkAssemblyLocations(AssemblyItems const& _items, vector<SourceLocation>
 	BOOST_CHECK_EQUAL(_items.size(), _locations.size());
 	for (size_t i = 0; i < min(_items.size(), _locations.size()); ++i)
 	{
+		SourceLocation location = _items[i].sourceLocation();
 		BOOST_CHECK_MESSAGE(
-			_items[i].location() == _locations[i],
+			location == _locations[i],
 			"Location mismatch for assembly item " + to_string(i) + ". Found: " +
-					(_items[i].location().sourceName ? *_items[i].location().sourceName + ":" : "(null source name)") +
-					to_string(_items[i].location().start) + "-" +
-					to_string(_items[i].location().end) + ", expected: " +
+					(location.sourceName ? *location.sourceName + ":" : "(null source name)") +
+					to_string(location.start) + "-" +
+					to_string(location.end) + ", expected: " +
 					(_locations[i].sourceName ? *_locations[i].sourceName + ":" : "(null source name)") +
 					to_string(_locations[i].start) + "-" +
 					to_string(_locations[i].end));
@@ -117,16 +120,81 @@ BOOST_AUTO_TEST_CASE(location_test)
 	}
 	)";
 	shared_ptr<string const> n = make_shared<string>("");
-	AssemblyItems items = compileContract(sourceCode);
+	auto scanner = make_shared<Scanner>(CharStream(sourceCode));
+	AssemblyItems items = compileContract(scanner);
 	vector<SourceLocation> locations =
 		vector<SourceLocation>(19, SourceLocation(2, 75, n)) +
 		vector<SourceLocation>(32, SourceLocation(20, 72, n)) +
-		vector<SourceLocation>{SourceLocation(42, 51, n), SourceLocation(65, 67, n)} +
-		vector<SourceLocation>(2, SourceLocation(58, 67, n)) +
+		vector<SourceLocation>{SourceLocation(65, 67, n)} +
 		vector<SourceLocation>(3, SourceLocation(20, 72, n));
 	checkAssemblyLocations(items, locations);
 }
 
+BOOST_AUTO_TEST_CASE(item_locations_and_data)
+{
+	SourceLocation location(3, 7, make_shared<string>("a.sol"));
+	AssemblyItem push(u256(1) << 255, location);
+	AssemblyItem copy = push;
+	copy.setData(u256(5));
+	BOOST_CHECK_EQUAL(push.data(), u256(1) << 255);
+	BOOST_CHECK_EQUAL(copy.data(), u256(5));
+	BOOST_CHECK(copy.sourceLocation() == location);
+
+	// Names are compared by content, not by the pointer they were created from.
+	AssemblyItem operation(Instruction::ADD, SourceLocation(3, 7, make_shared<string>("a.sol")));
+	BOOST_CHECK(operation.location() == push.location());
+	auto name = make_shared<string const>("b.sol");
+	operation.setLocation(SourceLocation(3, 7, name));
+	BOOST_CHECK(operation.location() != push.location());
+	BOOST_CHECK_EQUAL(*operation.sourceLocation().sourceName, "b.sol");
+	operation.setLocation(SourceLocation());
+	BOOST_CHECK(operation.location().isEmpty());
+	BOOST_CHECK(!operation.sourceLocation().sourceName);
+
+	// Items do not keep their source names alive.
+	operation.setLocation(SourceLocation(3, 7, name));
+	weak_ptr<string const> released = name;
+	name.reset();
+	BOOST_CHECK(released.expired());
+	BOOST_CHECK(!operation.sourceLocation().sourceName);
+	BOOST_CHECK_EQUAL(*push.sourceLocation().sourceName, "a.sol");
+}
+
+BOOST_AUTO_TEST_CASE(created_contract_is_included_unchanged)
+{
+	// The constructor of D stores a runtime function, so the creation code of D pushes
+	// tags of its runtime code.
+	string d = R"(
+	contract D {
+		function() internal returns (uint) f;
+		function D() { f = g; }
+		function g() internal returns (uint) { return 7; }
+		function h() returns (uint) { return f(); }
+	}
+	)";
+	CompilerStack alone;
+	alone.addSource("d", d);
+	BOOST_REQUIRE(alone.compile(true));
+	CompilerStack creating;
+	creating.addSource("d", d);
+	creating.addSource("c", "import \"d\"; contract C { function k() returns (D) { return new D(); } }");
+	BOOST_REQUIRE(creating.compile(true));
+
+	// D is not optimised again when it is included in C. The metadata differs, as it
+	// lists all sources.
+	auto assembly = [](CompilerStack const& _compiler)
+	{
+		ostringstream stream;
+		_compiler.streamAssembly(stream, "d:D");
+		string text = stream.str();
+		return text.substr(0, text.find("auxdata"));
+	};
+	BOOST_CHECK_EQUAL(assembly(alone), assembly(creating));
+	bytes const& created = creating.object("d:D").bytecode;
+	bytes const& creator = creating.object("c:C").bytecode;
+	BOOST_CHECK(search(creator.begin(), creator.end(), created.begin(), created.end()) != creator.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
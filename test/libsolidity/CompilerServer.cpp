@@ -0,0 +1,163 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @date 2017
+ * Unit tests for interface/CompilerServer.h.
+ */
+
+#include <string>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include <libsolidity/interface/CompilerServer.h>
+#include <libdevcore/JSON.h>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+string request(string const& _contractName)
+{
+	return R"({
+		"language": "Solidity",
+		"sources": { "a.sol": { "content": "contract )" + _contractName + R"( { function f() {} }" } },
+		"settings": { "outputSelection": { "*": { "*": [ "abi" ] } } }
+	})";
+}
+
+string frame(string const& _message)
+{
+	ostringstream framed;
+	CompilerServer::writeMessage(framed, _message);
+	return framed.str();
+}
+
+Json::Value parse(string const& _message)
+{
+	Json::Value ret;
+	BOOST_REQUIRE(Json::Reader().parse(_message, ret, false));
+	return ret;
+}
+
+vector<Json::Value> readResponses(string const& _output)
+{
+	vector<Json::Value> responses;
+	istringstream output(_output);
+	string message;
+	string error;
+	while (CompilerServer::readMessage(output, message, error))
+		responses.push_back(parse(message));
+	BOOST_CHECK(error.empty());
+	return responses;
+}
+
+} // end anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(CompilerServer)
+
+BOOST_AUTO_TEST_CASE(framing)
+{
+	istringstream input("Content-Length: 3\r\n\r\nabc\ncontent-length:2\n\nde");
+	string message;
+	string error;
+	BOOST_CHECK(solidity::CompilerServer::readMessage(input, message, error));
+	BOOST_CHECK_EQUAL(message, "abc");
+	BOOST_CHECK(solidity::CompilerServer::readMessage(input, message, error));
+	BOOST_CHECK_EQUAL(message, "de");
+	BOOST_CHECK(!solidity::CompilerServer::readMessage(input, message, error));
+	BOOST_CHECK(error.empty());
+
+	istringstream truncated("Content-Length: 10\r\n\r\nabc");
+	BOOST_CHECK(!solidity::CompilerServer::readMessage(truncated, message, error));
+	BOOST_CHECK_EQUAL(error, "Unexpected end of input in message body.");
+
+	istringstream noLength("Content-Type: json\r\n\r\n{}");
+	BOOST_CHECK(!solidity::CompilerServer::readMessage(noLength, message, error));
+	BOOST_CHECK_EQUAL(error, "Message header without Content-Length.");
+
+	istringstream tooLong("Content-Length: 99999999999\r\n\r\n{}");
+	BOOST_CHECK(!solidity::CompilerServer::readMessage(tooLong, message, error));
+	BOOST_CHECK_EQUAL(error.find("Content length 99999999999 exceeds the maximum"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(responses_in_request_order)
+{
+	solidity::CompilerServer server(ReadFile::Callback(), 3);
+	string requests;
+	for (size_t i = 0; i < 8; ++i)
+		requests += frame(request("C" + to_string(i)));
+	requests += frame("{ invalid json");
+	istringstream input(requests);
+	ostringstream output;
+	BOOST_CHECK(server.serve(input, output));
+
+	vector<Json::Value> responses = readResponses(output.str());
+	BOOST_REQUIRE_EQUAL(responses.size(), 9);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		BOOST_CHECK(responses[i]["contracts"]["a.sol"].isMember("C" + to_string(i)));
+		BOOST_CHECK(responses[i]["contracts"]["a.sol"]["C" + to_string(i)]["abi"].isArray());
+	}
+	BOOST_CHECK_EQUAL(responses[8]["errors"][0]["type"].asString(), "JSONError");
+}
+
+BOOST_AUTO_TEST_CASE(invalid_framing)
+{
+	solidity::CompilerServer server(ReadFile::Callback(), 1);
+	istringstream input(frame(request("C")) + "garbage\r\n\r\n" + frame(request("D")));
+	ostringstream output;
+	BOOST_CHECK(!server.serve(input, output));
+
+	vector<Json::Value> responses = readResponses(output.str());
+	BOOST_REQUIRE_EQUAL(responses.size(), 2);
+	BOOST_CHECK(responses[0]["contracts"]["a.sol"].isMember("C"));
+	BOOST_CHECK_EQUAL(responses[1]["errors"][0]["message"].asString(), "Invalid message header \"garbage\".");
+
+	istringstream tooLong(frame(request("C")) + "Content-Length: 99999999999\r\n\r\n");
+	ostringstream tooLongOutput;
+	BOOST_CHECK(!server.serve(tooLong, tooLongOutput));
+	responses = readResponses(tooLongOutput.str());
+	BOOST_REQUIRE_EQUAL(responses.size(), 2);
+	BOOST_CHECK(responses[0]["contracts"]["a.sol"].isMember("C"));
+	BOOST_CHECK_EQUAL(responses[1]["errors"][0]["type"].asString(), "JSONError");
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_submissions)
+{
+	solidity::CompilerServer server(ReadFile::Callback(), 4);
+	vector<future<solidity::CompilerServer::Result>> outputs;
+	for (size_t i = 0; i < 16; ++i)
+		outputs.push_back(server.submit(request("C" + to_string(i))));
+	for (size_t i = 0; i < outputs.size(); ++i)
+	{
+		Json::Value output = parse(outputs[i].get().output);
+		BOOST_CHECK(output["contracts"]["a.sol"].isMember("C" + to_string(i)));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
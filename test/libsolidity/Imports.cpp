@@ -24,6 +24,7 @@
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/AST.h>
 
 using namespace std;
 
@@ -202,6 +203,132 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent)
 	BOOST_CHECK(d.compile());
 }
 
+BOOST_AUTO_TEST_CASE(incremental_analysis)
+{
+	string e = "contract E { uint x; function g() { x = 2; } } pragma solidity >=0.0;";
+	string b = "import \"a\"; contract D is C { function h() returns (uint) { return f() + 1; } } pragma solidity >=0.0;";
+	CompilerStack c;
+	c.setIncrementalAnalysis(true);
+	c.addSource("a", "contract C { function f() returns (uint) { return 1; } } pragma solidity >=0.0;");
+	c.addSource("b", b);
+	c.addSource("e", e);
+	BOOST_REQUIRE(c.compile());
+	SourceUnit const* unaffected = &c.ast("e");
+
+	c.addSource("a", "contract C { function f() returns (uint) { return y; } } pragma solidity >=0.0;");
+	BOOST_CHECK(!c.compile());
+	string a = "contract C { uint y = 7; function f() returns (uint) { return y; } } pragma solidity >=0.0;";
+	c.addSource("a", a);
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK_EQUAL(&c.ast("e"), unaffected);
+
+	CompilerStack d;
+	d.addSource("a", a);
+	d.addSource("b", b);
+	d.addSource("e", e);
+	BOOST_REQUIRE(d.compile());
+	for (string const& contract: {"a:C", "b:D", "e:E"})
+		BOOST_CHECK(c.object(contract).bytecode == d.object(contract).bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_analysis_bound_functions)
+{
+	// The type of "data" belongs to the unaffected source, its members bound in "a" are
+	// looked up again after "a" changed.
+	string l = "contract Base { uint[] public data; } pragma solidity >=0.0;";
+	auto source = [](string const& _name)
+	{
+		return
+			"import \"l\"; pragma solidity >=0.0;"
+			"library L { function " + _name + "(uint[] storage a) returns (uint) { return a.length; } }"
+			"contract A is Base { using L for uint[]; function f() returns (uint) { return data." + _name + "(); } }";
+	};
+	CompilerStack c;
+	c.setIncrementalAnalysis(true);
+	c.addSource("l", l);
+	c.addSource("a", source("sum"));
+	BOOST_REQUIRE(c.compile());
+	for (string const& name: {"total", "sum", "count"})
+	{
+		c.addSource("a", source(name));
+		BOOST_REQUIRE(c.compile());
+		CompilerStack d;
+		d.addSource("l", l);
+		d.addSource("a", source(name));
+		BOOST_REQUIRE(d.compile());
+		BOOST_CHECK(c.object("a:A").bytecode == d.object("a:A").bytecode);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	map<string, string> files{
+		{"b", "import \"d\"; contract B is D { function g() returns (uint) { return f() + 1; } } pragma solidity >=0.0;"},
+		{"c", "contract C { uint x; function h() returns (uint) { return x; } } pragma solidity >=0.0;"},
+		{"d", "contract D { function f() returns (uint) { return 2; } } pragma solidity >=0.0;"},
+		{"e", "contract E { function f( } pragma solidity >=0.0;"},
+		{"f", "contract F { uint[] x = ; } pragma solidity >=0.0;"}
+	};
+	ReadFile::Callback readFile = [&](string const& _path)
+	{
+		return files.count(_path) ? ReadFile::Result{true, files[_path]} : ReadFile::Result{false, "not found"};
+	};
+	string a = "import \"b\"; import \"c\"; contract A is B, C {} pragma solidity >=0.0;";
+	string g = "import \"e\"; import \"f\"; import \"h\"; contract G {} pragma solidity >=0.0;";
+
+	// Imported sources are only discovered while parsing, the node IDs do not depend on the order
+	// in which they are parsed.
+	CompilerStack sequential(readFile);
+	sequential.addSource("a", a);
+	BOOST_REQUIRE(sequential.compile());
+	CompilerStack parallel(readFile);
+	parallel.setParallelism(4);
+	parallel.addSource("a", a);
+	BOOST_REQUIRE(parallel.compile());
+	BOOST_CHECK(parallel.sourceNames() == sequential.sourceNames());
+	for (string const& source: sequential.sourceNames())
+	{
+		BOOST_CHECK_EQUAL(parallel.ast(source).id(), sequential.ast(source).id());
+		BOOST_CHECK_EQUAL(parallel.ast(source).nodes().front()->id(), sequential.ast(source).nodes().front()->id());
+	}
+	BOOST_CHECK(parallel.object("a:A").bytecode == sequential.object("a:A").bytecode);
+
+	// Errors are reported in the same order as in sequential parsing.
+	CompilerStack sequentialErrors(readFile);
+	sequentialErrors.addSource("g", g);
+	BOOST_CHECK(!sequentialErrors.parse());
+	CompilerStack parallelErrors(readFile);
+	parallelErrors.setParallelism(3);
+	parallelErrors.addSource("g", g);
+	BOOST_CHECK(!parallelErrors.parse());
+	BOOST_REQUIRE_EQUAL(sequentialErrors.errors().size(), 4);
+	BOOST_REQUIRE_EQUAL(parallelErrors.errors().size(), sequentialErrors.errors().size());
+	for (size_t i = 0; i < sequentialErrors.errors().size(); ++i)
+		BOOST_CHECK_EQUAL(
+			*boost::get_error_info<errinfo_comment>(*parallelErrors.errors()[i]),
+			*boost::get_error_info<errinfo_comment>(*sequentialErrors.errors()[i])
+		);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_failing_import_callback)
+{
+	map<string, string> files{
+		{"b", "import \"d\"; contract B {} pragma solidity >=0.0;"},
+		{"c", "contract C {} pragma solidity >=0.0;"}
+	};
+	ReadFile::Callback readFile = [&](string const& _path)
+	{
+		if (!files.count(_path))
+			BOOST_THROW_EXCEPTION(Exception() << errinfo_comment("Cannot read " + _path));
+		return ReadFile::Result{true, files[_path]};
+	};
+	// The callback throws while the other sources are still being parsed.
+	CompilerStack c(readFile);
+	c.setParallelism(3);
+	c.addSource("a", "import \"b\"; import \"c\"; contract A {} pragma solidity >=0.0;");
+	BOOST_CHECK_THROW(c.parse(), Exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -33,6 +33,7 @@ using namespace std;
 extern "C"
 {
 extern char const* compileJSONMulti(char const* _input, bool _optimize);
+extern char const* compileStandardBatch(char const* _input, void* _readCallback, unsigned _threads);
 }
 
 namespace dev
@@ -104,6 +105,37 @@ BOOST_AUTO_TEST_CASE(basic_compilation)
 		"\"src\":\"0:14:0\"}],\"id\":2,\"name\":\"SourceUnit\",\"src\":\"0:14:0\"}"
 	);
 }
+
+BOOST_AUTO_TEST_CASE(standard_batch)
+{
+	string input = "[";
+	for (size_t i = 0; i < 6; ++i)
+		input += R"({
+			"language": "Solidity",
+			"sources": { "a.sol": { "content": "contract C)" + to_string(i) + R"( {}" } },
+			"settings": { "outputSelection": { "*": { "*": [ "evm.bytecode.object" ] } } }
+		},)";
+	input += R"({ "language": "Solidity" }])";
+
+	Json::Value result;
+	BOOST_REQUIRE(Json::Reader().parse(compileStandardBatch(input.c_str(), nullptr, 2), result, false));
+	BOOST_REQUIRE(result.isArray());
+	BOOST_REQUIRE_EQUAL(result.size(), 7);
+	for (size_t i = 0; i < 6; ++i)
+	{
+		Json::Value const& contract = result[Json::ArrayIndex(i)]["output"]["contracts"]["a.sol"]["C" + to_string(i)];
+		BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+		BOOST_CHECK(result[Json::ArrayIndex(i)]["time"].isDouble());
+	}
+	BOOST_CHECK_EQUAL(
+		result[6]["output"]["errors"][0]["message"].asString(),
+		"No input sources specified."
+	);
+
+	BOOST_REQUIRE(Json::Reader().parse(compileStandardBatch("{}", nullptr, 1), result, false));
+	BOOST_CHECK_EQUAL(result["errors"][0]["message"].asString(), "Input is not a JSON array.");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
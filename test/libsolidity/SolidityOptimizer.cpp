@@ -27,6 +27,8 @@
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/OptimiserPassManager.h>
+#include <libevmasm/ConstantOptimiser.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/lexical_cast.hpp>
@@ -148,13 +150,13 @@ public:
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 
-	AssemblyItems CFG(AssemblyItems const& _input)
+	AssemblyItems CFG(AssemblyItems const& _input, set<u256> const& _externalTags = set<u256>())
 	{
 		AssemblyItems output = _input;
 		// Running it four times should be enough for these tests.
 		for (unsigned i = 0; i < 4; ++i)
 		{
-			ControlFlowGraph cfg(output);
+			ControlFlowGraph cfg(output, true, _externalTags);
 			AssemblyItems optItems;
 			for (BasicBlock const& block: cfg.optimisedBlocks())
 				copy(output.begin() + block.begin, output.begin() + block.end,
@@ -164,9 +166,13 @@ public:
 		return output;
 	}
 
-	void checkCFG(AssemblyItems const& _input, AssemblyItems const& _expectation)
+	void checkCFG(
+		AssemblyItems const& _input,
+		AssemblyItems const& _expectation,
+		set<u256> const& _externalTags = set<u256>()
+	)
 	{
-		AssemblyItems output = CFG(_input);
+		AssemblyItems output = CFG(_input, _externalTags);
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 
@@ -434,6 +440,70 @@ BOOST_AUTO_TEST_CASE(sequence_number_for_calls)
 	compareVersions("f(string,string)", 0x40, 0x80, 3, "abc", 3, "def");
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_internal_function_pointers_in_storage)
+{
+	// The control flow graph optimiser carries constants into the blocks, the tags of internal
+	// functions are only known to it through storage here.
+	char const* sourceCode = R"(
+		contract C {
+			function() internal returns (uint) stored;
+			function a() internal returns (uint) { return 7; }
+			function b() internal returns (uint) { return 9; }
+			function set(bool x) { if (x) stored = a; else stored = b; }
+			function g() returns (uint) { return stored(); }
+			function f(bool x) returns (uint) { set(x); uint r = stored(); set(!x); return r * 10 + stored(); }
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f(bool)", true);
+	compareVersions("f(bool)", false);
+	compareVersions("set(bool)", true);
+	compareVersions("g()");
+	compareVersions("set(bool)", false);
+	compareVersions("g()");
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_function_pointer_stored_by_constructor)
+{
+	// The constructor stores the runtime tag of the function together with its own.
+	char const* sourceCode = R"(
+		contract C {
+			function(uint) internal returns (uint) op;
+			function C() { op = double; }
+			function double(uint x) internal returns (uint) { return 2 * x; }
+			function triple(uint x) internal returns (uint) { return 3 * x; }
+			function g(uint x) returns (uint) { return op(x); }
+			function f(uint x) returns (uint) { uint r = op(x); op = triple; return r + op(x); }
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("g(uint256)", 5);
+	compareVersions("f(uint256)", 7);
+	compareVersions("g(uint256)", 5);
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_internal_calls_with_several_return_sites)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint constant k = 3;
+			function g(uint x) internal returns (uint) { if (x > 10) return x - 10; return x + k; }
+			function h(uint x, uint y) internal returns (uint, uint) { return (g(x), g(y) + k); }
+			function f(uint x) returns (uint a, uint b, uint c, uint d) {
+				a = g(x);
+				b = g(a * k);
+				(c, d) = h(b, a);
+				d += g(c) + g(d);
+			}
+		}
+	)";
+	compileBothVersions(sourceCode);
+	compareVersions("f(uint256)", 0);
+	compareVersions("f(uint256)", 4);
+	compareVersions("f(uint256)", 12);
+	compareVersions("f(uint256)", u256(-1));
+}
+
 BOOST_AUTO_TEST_CASE(cse_intermediate_swap)
 {
 	eth::KnownState state;
@@ -526,6 +596,22 @@ BOOST_AUTO_TEST_CASE(cse_double_iszero)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cse_nested_patterns)
+{
+	// (X + A) - X
+	checkCSE({Instruction::DUP1, u256(5), Instruction::ADD, Instruction::SUB}, {Instruction::POP, u256(5)});
+	// X - (X + A)
+	checkCSE(
+		{u256(5), Instruction::DUP2, Instruction::ADD, Instruction::DUP2, Instruction::SUB},
+		{u256(0) - u256(5)}
+	);
+	// (X + A) + B
+	checkCSE(
+		{u256(3), Instruction::DUP2, Instruction::ADD, u256(4), Instruction::ADD},
+		{u256(7), Instruction::DUP2, Instruction::ADD}
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cse_associativity)
 {
 	AssemblyItems input{
@@ -1094,6 +1180,70 @@ BOOST_AUTO_TEST_CASE(control_flow_graph_do_not_remove_returned_to)
 	checkCFG(input, {u256(2)});
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_graph_keep_external_tags)
+{
+	// Tag 1 is not pushed here, but by the parent assembly.
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(2),
+		Instruction::STOP
+	};
+	checkCFG(input, {u256(0), Instruction::SLOAD, Instruction::JUMP});
+	checkCFG(input, input, {1});
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_keep_stored_tags)
+{
+	// Tag 1 escapes through storage and is the target of the unknown jump.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(2),
+		Instruction::STOP
+	};
+	checkCFG(input, {
+		AssemblyItem(PushTag, 1),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(2),
+		Instruction::STOP
+	});
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph_foreign_tags)
+{
+	// Pushing a tag of a sub-assembly does not create a block reference.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1).toSubAssemblyTag(0),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 1),
+		u256(2)
+	};
+	checkCFG(input, {
+		AssemblyItem(PushTag, 1).toSubAssemblyTag(0),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	});
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator)
 {
 	AssemblyItems input{
@@ -1155,6 +1305,53 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_fallthrough)
+{
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 5),
+		AssemblyItem(PushTag, 6),
+		AssemblyItem(PushTag, 7),
+		AssemblyItem(Tag, 1),
+		u256(7),
+		AssemblyItem(Tag, 3),
+		u256(8),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(7),
+		AssemblyItem(Tag, 4),
+		u256(8),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 5),
+		u256(7),
+		u256(8),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 6),
+		u256(7),
+		u256(8),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 6),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 7),
+		u256(7),
+		u256(8),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMP
+	};
+	BlockDeduplicator dedup(input);
+	BOOST_CHECK(dedup.deduplicate());
+
+	// Once the loop of tag 6 jumps to tag 5, the block of tag 7 equals the one of tag 6.
+	map<u256, u256> expectation{{2, 1}, {4, 3}, {6, 5}, {7, 6}};
+	BOOST_CHECK(dedup.replacedTags() == expectation);
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1215,6 +1412,319 @@ BOOST_AUTO_TEST_CASE(peephole_double_push)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(peephole_rescans_after_replacement)
+{
+	// Each replacement enables the next one.
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::ADD,
+		Instruction::POP,
+		Instruction::CALLDATASIZE,
+		Instruction::CALLVALUE,
+		Instruction::SWAP1,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		Instruction::CALLDATASIZE,
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL(peepOpt.replacements(), 4);
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_conditional_jumps)
+{
+	AssemblyItems items{
+		Instruction::CALLDATASIZE,
+		Instruction::ISZERO,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 2),
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		Instruction::CALLDATASIZE,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(Tag, 2),
+		Instruction::STOP
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(pass_manager_skips_unchanged_blocks)
+{
+	AssemblyItems items{
+		Instruction::CALLDATASIZE,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS,
+		Instruction::CALLDATASIZE,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS,
+		u256(1),
+		u256(2),
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS
+	};
+	AssemblyItems expectation{
+		Instruction::CALLDATASIZE,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS,
+		Instruction::CALLDATASIZE,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS,
+		u256(3),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::GAS
+	};
+	OptimiserPassManager passManager(items, true);
+	BOOST_CHECK(passManager.run().empty());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	auto const& cse = passManager.statistics(OptimiserPassManager::CSE);
+	BOOST_CHECK_EQUAL(cse.runs, 2);
+	BOOST_CHECK_EQUAL(cse.changes, 1);
+	// The second block in the first round and the first two blocks in the second round.
+	BOOST_CHECK_EQUAL(cse.skippedBlocks, 3);
+}
+
+BOOST_AUTO_TEST_CASE(pass_manager_parallel_blocks)
+{
+	AssemblyItems items;
+	for (unsigned i = 0; i < 100; ++i)
+		items += AssemblyItems{
+			u256(i),
+			u256(1),
+			Instruction::ADD,
+			Instruction::CALLDATASIZE,
+			Instruction::SSTORE,
+			Instruction::DUP1,
+			u256(i % 3),
+			Instruction::ADD,
+			Instruction::GAS
+		};
+	AssemblyItems sequential = items;
+	OptimiserPassManager sequentialManager(sequential, true);
+	sequentialManager.run();
+	AssemblyItems parallel = items;
+	ThreadPool threadPool(4);
+	OptimiserPassManager parallelManager(parallel, true, &threadPool);
+	parallelManager.run();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		sequential.begin(), sequential.end(),
+		parallel.begin(), parallel.end()
+	);
+	BOOST_CHECK_EQUAL(
+		sequentialManager.statistics(OptimiserPassManager::CSE).changes,
+		parallelManager.statistics(OptimiserPassManager::CSE).changes
+	);
+	BOOST_CHECK(sequential.size() < items.size());
+}
+
+BOOST_AUTO_TEST_CASE(pass_manager_constants_across_blocks)
+{
+	// The value 2 is on the stack at both ways to enter tag 1.
+	AssemblyItems items{
+		u256(2),
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(3),
+		Instruction::MUL,
+		u256(1),
+		Instruction::ADD,
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(2),
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		Instruction::POP,
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	OptimiserPassManager passManager(items, true);
+	passManager.run();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(passManager.statistics(OptimiserPassManager::ControlFlow).changes > 0);
+}
+
+BOOST_AUTO_TEST_CASE(pass_manager_storage_across_blocks)
+{
+	// Slot 0 contains 5 at the fall-through and at both ways to enter tag 1.
+	AssemblyItems items{
+		u256(5),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::SLOAD,
+		u256(1),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::SLOAD,
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(5),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(5),
+		u256(1),
+		Instruction::SSTORE,
+		AssemblyItem(Tag, 1),
+		u256(5),
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	OptimiserPassManager passManager(items, true);
+	passManager.run();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(pass_manager_memory_across_blocks)
+{
+	// Memory at 0x40 is the same at both ways to enter tag 1, memory at 0 is not.
+	AssemblyItems items{
+		u256(0x60),
+		u256(0x40),
+		Instruction::MSTORE,
+		u256(1),
+		u256(0),
+		Instruction::MSTORE,
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(2),
+		u256(0),
+		Instruction::MSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::MLOAD,
+		u256(0x40),
+		Instruction::MLOAD,
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	AssemblyItems expectation{
+		u256(0x60),
+		u256(0x40),
+		Instruction::MSTORE,
+		u256(1),
+		u256(0),
+		Instruction::MSTORE,
+		Instruction::CALLDATASIZE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(2),
+		u256(0),
+		Instruction::MSTORE,
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::MLOAD,
+		u256(0x60),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	OptimiserPassManager passManager(items, true);
+	passManager.run();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_cache)
+{
+	ConstantOptimisationMethod::Params params;
+	params.isCreation = false;
+	params.runs = 1;
+	params.multiplicity = 3;
+	u256 value = u256(0x1234) << 200;
+	Assembly assembly;
+
+	// The table is shared by the whole process, the test does not leave entries behind.
+	ComputeMethod::clearCache();
+	AssemblyItems routine = ComputeMethod(params, value).execute(assembly);
+	BOOST_CHECK(routine.size() > 1);
+	// The representation is the same whether it is taken from the table or searched again.
+	AssemblyItems cached = ComputeMethod(params, value).execute(assembly);
+	BOOST_CHECK_EQUAL_COLLECTIONS(cached.begin(), cached.end(), routine.begin(), routine.end());
+	ComputeMethod::clearCache();
+	AssemblyItems searched = ComputeMethod(params, value).execute(assembly);
+	BOOST_CHECK_EQUAL_COLLECTIONS(searched.begin(), searched.end(), routine.begin(), routine.end());
+	ComputeMethod::clearCache();
+}
+
 BOOST_AUTO_TEST_CASE(computing_constants)
 {
 	char const* sourceCode = R"(
@@ -1533,6 +1533,37 @@ BOOST_AUTO_TEST_CASE(interface)
 	BOOST_CHECK(successParse(text));
 }
 
+BOOST_AUTO_TEST_CASE(arena_allocation)
+{
+	char const* text = R"(
+		contract test {
+			uint256 stateVar;
+			function f(uint a) returns (uint b) { b = a + stateVar; }
+		}
+	)";
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	auto arena = make_shared<ASTArena>();
+	ASTPointer<SourceUnit> sourceUnit = Parser(errorReporter, arena).parse(make_shared<Scanner>(CharStream(text)));
+	BOOST_REQUIRE(sourceUnit);
+	BOOST_CHECK(errors.empty());
+	BOOST_CHECK(arena->capacity() > 0);
+	auto contract = dynamic_pointer_cast<ContractDefinition>(sourceUnit->nodes().front());
+	BOOST_REQUIRE(contract);
+	BOOST_CHECK_EQUAL(contract->name(), "test");
+	BOOST_CHECK_EQUAL(contract->definedFunctions().size(), 1);
+	contract->annotation().isFullyImplemented = false;
+	BOOST_CHECK(!contract->annotation().isFullyImplemented);
+
+	// The nodes keep the arena alive and release it together with the last node.
+	weak_ptr<ASTArena> weakArena = arena;
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	sourceUnit.reset();
+	contract.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
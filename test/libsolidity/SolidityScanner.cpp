@@ -393,6 +393,80 @@ BOOST_AUTO_TEST_CASE(invalid_hex_literal_nonhex_string)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
 }
 
+BOOST_AUTO_TEST_CASE(shared_source)
+{
+	auto source = std::make_shared<std::string const>("contract C {}");
+	Scanner scanner(CharStream(source), "C.sol");
+	BOOST_CHECK_EQUAL(&scanner.source(), source.get());
+	Scanner copy = scanner;
+	copy.reset();
+	BOOST_CHECK(copy.sharedSource() == source);
+	BOOST_CHECK_EQUAL(copy.currentToken(), Token::Contract);
+	BOOST_CHECK_EQUAL(copy.lineAtPosition(3), "contract C {}");
+}
+
+BOOST_AUTO_TEST_CASE(line_and_column_translation)
+{
+	for (std::string const source: {"", "\n", "a", "\nab\n\ncd\r\nef", "ab\ncd\n"})
+	{
+		CharStream stream(source);
+		for (int position = 0; position <= int(source.size()) + 1; ++position)
+		{
+			// Straightforward scans of the source for comparison.
+			size_t clamped = std::min<size_t>(source.size(), position);
+			size_t lineStart = clamped == 0 ? std::string::npos : source.rfind('\n', clamped - 1);
+			lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
+			int line;
+			int column;
+			std::tie(line, column) = stream.translatePositionToLineColumn(position);
+			BOOST_CHECK_EQUAL(line, std::count(source.begin(), source.begin() + clamped, '\n'));
+			BOOST_CHECK_EQUAL(column, clamped - lineStart);
+
+			// The line before a newline character is printed.
+			size_t printedStart = source.rfind('\n', clamped > 0 ? clamped - 1 : 0);
+			printedStart = printedStart == std::string::npos ? 0 : printedStart + 1;
+			size_t printedEnd = std::min(source.find('\n', printedStart), source.size());
+			BOOST_CHECK_EQUAL(stream.lineAtPosition(position), source.substr(printedStart, printedEnd - printedStart));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(comments_and_whitespace_runs)
+{
+	Scanner scanner(CharStream("a /* x * / ** */b//c*/\n\t \r c/*/ d */ e /*/"));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 16);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "c");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "e");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+}
+
+BOOST_AUTO_TEST_CASE(sized_elementary_types)
+{
+	Scanner scanner(CharStream("uint8 int256 uint264 bytes32 bytes33 fixed0x8 ufixed128x128 uint08 uint99999999999 bytesx uint8x"));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::UIntM);
+	BOOST_CHECK_EQUAL(std::get<0>(scanner.currentTokenInfo()), 8);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::IntM);
+	BOOST_CHECK_EQUAL(std::get<0>(scanner.currentTokenInfo()), 256);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::BytesM);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::FixedMxN);
+	BOOST_CHECK_EQUAL(std::get<1>(scanner.currentTokenInfo()), 8);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UFixedMxN);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UIntM);
+	BOOST_CHECK_EQUAL(std::get<0>(scanner.currentTokenInfo()), 8);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libdevcore/SHA3.h>
 #include <boost/test/unit_test.hpp>
@@ -79,13 +80,13 @@ BOOST_AUTO_TEST_CASE(storage_layout_mapping)
 
 BOOST_AUTO_TEST_CASE(storage_layout_arrays)
 {
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(1), 32).storageSize() == 1);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(1), 33).storageSize() == 2);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(2), 31).storageSize() == 2);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(7), 8).storageSize() == 2);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(7), 9).storageSize() == 3);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(31), 9).storageSize() == 9);
-	BOOST_CHECK(ArrayType(DataLocation::Storage, make_shared<FixedBytesType>(32), 9).storageSize() == 9);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(1), 32).storageSize() == 1);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(1), 33).storageSize() == 2);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(2), 31).storageSize() == 2);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(7), 8).storageSize() == 2);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(7), 9).storageSize() == 3);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(31), 9).storageSize() == 9);
+	BOOST_CHECK(ArrayType(DataLocation::Storage, TypeProvider::fixedBytes(32), 9).storageSize() == 9);
 }
 
 BOOST_AUTO_TEST_CASE(type_identifiers)
@@ -153,6 +154,23 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	BOOST_CHECK(TypeProvider::uint256() == TypeProvider::integer(256));
+	BOOST_CHECK(TypeProvider::address() == TypeProvider::integer(0, IntegerType::Modifier::Address));
+	BOOST_CHECK(TypeProvider::integer(8, IntegerType::Modifier::Signed) != TypeProvider::integer(8));
+	BOOST_CHECK(Type::fromElementaryTypeName("uint") == TypeProvider::uint256());
+	BOOST_CHECK(Type::fromElementaryTypeName("bytes32") == TypeProvider::fixedBytes(32));
+	BOOST_CHECK(Type::fromElementaryTypeName("bool") == TypeProvider::boolean());
+	BOOST_CHECK(TypeProvider::fixedPoint(128, 128) == TypeProvider::fixedPoint(128, 128));
+	BOOST_CHECK(*TypeProvider::integer(64) == *Type::fromElementaryTypeName("uint64"));
+	BOOST_CHECK(*TypeProvider::integer(64) != *TypeProvider::integer(64, IntegerType::Modifier::Signed));
+	BOOST_CHECK(
+		ArrayType(DataLocation::Memory, TypeProvider::fixedBytes(4)) ==
+		ArrayType(DataLocation::Memory, Type::fromElementaryTypeName("bytes4"))
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -23,7 +23,9 @@
 #include <iostream>
 #include <regex>
 #include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libdevcore/JSON.h>
 
 #include "../Metadata.h"
@@ -228,6 +230,103 @@ BOOST_AUTO_TEST_CASE(basic_compilation)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_compilation)
+{
+	string sources = R"(
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; function f(uint a) returns (uint) { x += a; return x * 2; } }"
+			},
+			"fileB": {
+				"content": "import \"fileA\"; contract B { A a; function B() { a = new A(); } function g() returns (uint) { return a.f(7); } }"
+			},
+			"fileC": {
+				"content": "import \"fileA\"; contract C is A { function h() returns (A) { return new A(); } }"
+			},
+			"fileD": {
+				"content": "import \"fileB\"; import \"fileC\"; contract D { function k() { new B(); new C(); } }"
+			}
+		},
+	)";
+	string sequential = string(R"({ "language": "Solidity", )") + sources + R"( "settings": { "optimizer": { "enabled": true } } })";
+	string parallel = string(R"({ "language": "Solidity", )") + sources + R"( "settings": { "optimizer": { "enabled": true }, "parallelism": 4 } })";
+	Json::Value sequentialResult = compile(sequential);
+	BOOST_CHECK(containsAtMostWarnings(sequentialResult));
+	BOOST_CHECK(getContractResult(sequentialResult, "fileD", "D").isObject());
+	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(compile(parallel)), dev::jsonCompactPrint(sequentialResult));
+}
+
+BOOST_AUTO_TEST_CASE(output_selection)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "abi" ] },
+				"fileB": { "*": [ "evm.bytecode.object" ], "": [ "ast" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() { } }"
+			},
+			"fileB": {
+				"content": "contract B { function g() { } }"
+			},
+			"fileC": {
+				"content": "contract C { function h() { } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_REQUIRE(contract["abi"].isArray());
+	BOOST_CHECK_EQUAL(contract["abi"].size(), 1u);
+	BOOST_CHECK(!contract.isMember("evm"));
+	BOOST_CHECK(!contract.isMember("metadata"));
+	contract = getContractResult(result, "fileB", "B");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(!contract.isMember("abi"));
+	BOOST_REQUIRE(contract["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(!contract["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(!contract["evm"]["bytecode"].isMember("opcodes"));
+	BOOST_CHECK(!contract["evm"].isMember("gasEstimates"));
+	BOOST_CHECK(!getContractResult(result, "fileC", "C").isObject());
+	BOOST_CHECK(result["sources"]["fileB"]["ast"].isObject());
+	BOOST_CHECK(!result["sources"]["fileA"].isMember("ast"));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"cache": { "directory": ")" + directory.string() + R"(" }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() returns (uint) { return 7; } }"
+			}
+		}
+	}
+	)";
+	Json::Value first = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(first));
+	BOOST_CHECK(getContractResult(first, "fileA", "A").isObject());
+	Json::Value second = compile(input);
+	BOOST_CHECK_EQUAL(dev::jsonCompactPrint(second), dev::jsonCompactPrint(first));
+	CompilationCache::Statistics statistics = CompilationCache(directory.string()).statistics();
+	BOOST_CHECK_EQUAL(statistics.hits, 1u);
+	BOOST_CHECK_EQUAL(statistics.misses, 1u);
+	boost::filesystem::remove_all(directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }